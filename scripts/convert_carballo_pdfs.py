@@ -0,0 +1,61 @@
+"""
+Convert pickled Carballo PDF interpolators to the tables shipped with whirlwind.
+
+Earlier versions of whirlwind shipped the phase gradient PDFs as pickled
+`scipy.interpolate.RegularGridInterpolator` objects. This script reads such pickles and
+writes the grid and the tabulated values of each one to a spline file with
+`whirlwind.spline.save_samples`, from which `whirlwind._cost` reconstructs the same
+interpolators.
+
+Usage::
+
+    python scripts/convert_carballo_pdfs.py PDF0_PICKLE PDF1_PICKLE [OUTPUT_DIR]
+
+The pickles may be recovered from the git history, e.g. with
+``git show <commit>:src/whirlwind/carballo-pdf-0-spline.pkl``.
+"""
+
+from __future__ import annotations
+
+import argparse
+import pickle
+from pathlib import Path
+
+import numpy as np
+
+from whirlwind.spline import save_samples
+
+ROOT = Path(__file__).resolve().parents[1]
+
+
+def load_tables(path: Path) -> tuple[tuple[np.ndarray, ...], np.ndarray]:
+    """Read the grid and the tabulated values of a pickled interpolator."""
+    with path.open("rb") as f:
+        interp = pickle.load(f)
+
+    # Read the attributes directly, since the pickles predate some of the attributes
+    # that newer versions of scipy expect to find.
+    state = vars(interp)
+    if state["method"] != "linear" or not np.isnan(state["fill_value"]):
+        msg = f"unexpected interpolator settings in {path}"
+        raise ValueError(msg)
+    return tuple(state["grid"]), np.asarray(state["values"])
+
+
+def main() -> None:
+    """Convert the pickles."""
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("pdf0", type=Path)
+    parser.add_argument("pdf1", type=Path)
+    parser.add_argument(
+        "output_dir", type=Path, nargs="?", default=ROOT / "src" / "whirlwind"
+    )
+    args = parser.parse_args()
+
+    for i, path in enumerate((args.pdf0, args.pdf1)):
+        knots, samples = load_tables(path)
+        save_samples(args.output_dir / f"carballo-pdf-{i}-table.bin", knots, samples)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,5 +1,5 @@
 from . import graph, network, spline
-from ._unwrap import unwrap
+from ._unwrap import unwrap, unwrap_stack
 
 # The `_version` module is auto-generated by setuptools_scm at install time.
 from ._version import __version__, __version_tuple__
@@ -11,4 +11,5 @@ __all__ = [
     "network",
     "spline",
     "unwrap",
+    "unwrap_stack",
 ]
@@ -0,0 +1,226 @@
+import numpy as np
+import scipy.sparse
+import scipy.sparse.csgraph
+
+from .graph import CSRGraph, RectangularGridGraph
+from .network import Network, primal_dual
+
+__all__ = [
+    "primal_dual_contracted",
+]
+
+
+def _find_edges(  # type: ignore[no-untyped-def]
+    tails, heads, query_tails, query_heads, num_vertices
+):
+    """
+    Find the edges with the specified tail & head vertices.
+
+    Returns an array containing the index of an edge from each query tail to the
+    corresponding query head, and a boolean array that indicates whether such an edge
+    exists. Where it does not, the first array is unspecified.
+    """
+    keys = tails * num_vertices + heads
+    order = np.argsort(keys, kind="stable")
+    sorted_keys = keys[order]
+
+    query_keys = query_tails * num_vertices + query_heads
+    pos = np.searchsorted(sorted_keys, query_keys)
+    pos = np.minimum(pos, len(keys) - 1)
+    return order[pos], sorted_keys[pos] == query_keys
+
+
+def _get_depths(parent: np.ndarray) -> np.ndarray:
+    """
+    Get the depth of each vertex in a forest, by pointer jumping.
+
+    `parent` contains the index of the parent of each vertex. Roots are their own
+    parents.
+    """
+    depth = (parent != np.arange(len(parent))).astype(np.int64)
+    ancestor = parent.copy()
+    while True:
+        next_ancestor = ancestor[ancestor]
+        if np.array_equal(next_ancestor, ancestor):
+            return depth
+        depth += depth[ancestor]
+        ancestor = next_ancestor
+
+
+def _route_within_components(  # type: ignore[no-untyped-def]
+    free_tails, free_heads, labels, excess, num_vertices
+):
+    """
+    Route the remaining excess of each vertex within its zero-cost component.
+
+    The excess is moved along a spanning tree of each component. Raises ValueError if
+    the total excess of any component is nonzero, since it could not be routed.
+
+    Returns the (child, parent, amount) of each tree edge, where `amount` is the flow
+    from child to parent (negative if the flow is from parent to child).
+    """
+    component_excess = np.bincount(labels, weights=excess)
+    if np.any(component_excess != 0):
+        msg = (
+            f"{np.count_nonzero(component_excess)} zero-cost region(s) have a nonzero"
+            " net excess that cannot be routed within the region"
+        )
+        raise ValueError(msg)
+
+    # Connect a virtual root to one vertex in each component so that the spanning
+    # forest can be found by a single breadth-first search.
+    root = num_vertices
+    _, representatives = np.unique(labels, return_index=True)
+    rows = np.concatenate([free_tails, np.full(len(representatives), root)])
+    cols = np.concatenate([free_heads, representatives])
+    adjacency = scipy.sparse.coo_array(
+        (np.ones(len(rows), dtype=np.int8), (rows, cols)),
+        shape=(num_vertices + 1, num_vertices + 1),
+    ).tocsr()
+    _, predecessors = scipy.sparse.csgraph.breadth_first_order(
+        adjacency, root, directed=False, return_predecessors=True
+    )
+
+    parent = np.where(predecessors < 0, np.arange(num_vertices + 1), predecessors)
+    depth = _get_depths(parent)
+
+    # Accumulate the excess of each subtree, from the deepest vertices upward.
+    subtree = np.append(excess, 0).astype(np.int64)
+    by_depth = np.argsort(depth, kind="stable")
+    bounds = np.searchsorted(depth[by_depth], np.arange(depth.max() + 1))
+    for d in range(depth.max(), 1, -1):
+        end = bounds[d + 1] if d + 1 < len(bounds) else len(by_depth)
+        vertices = by_depth[bounds[d] : end]
+        np.add.at(subtree, parent[vertices], subtree[vertices])
+
+    # Vertices at depth 1 are the component representatives, which are attached to the
+    # virtual root. Every other vertex is connected to its parent by a zero-cost edge.
+    child = np.flatnonzero(depth[:num_vertices] >= 2)
+    return child, parent[child], subtree[child]
+
+
+def primal_dual_contracted(
+    graph: RectangularGridGraph,
+    surplus: np.ndarray,
+    cost: np.ndarray,
+    maxiter: int = 0,
+) -> Network:
+    """
+    Solve a minimum cost flow problem after contracting zero-cost regions.
+
+    Each connected component of the graph whose vertices are joined by zero-cost edges
+    (in both directions) is contracted into a single node whose surplus is the sum of
+    the surpluses of its vertices. The resulting (much smaller, for scenes with large
+    masked or zero-cost areas) network is solved by `primal_dual`. The flows are then
+    expanded back to the original graph: flow on edges between components is copied
+    directly, and the excess left at each vertex of a component is routed along a
+    spanning tree of zero-cost edges.
+
+    Unit capacities are enforced on the edges between components. Within a component,
+    more than one unit of flow may be routed along a zero-cost edge, so the total cost
+    of the solution may be less than that of a unit-capacity solution of the original
+    network when flow would otherwise be forced out of a zero-cost region.
+
+    Parameters
+    ----------
+    graph : RectangularGridGraph
+        The original graph.
+    surplus : numpy.ndarray
+        The surplus of each vertex, indexed by vertex index.
+    cost : numpy.ndarray
+        The cost of each edge, indexed by edge index.
+    maxiter : int, optional
+        Passed to `primal_dual` for the contracted network. Defaults to 0.
+
+    Returns
+    -------
+    Network
+        An uncapacitated network over the original graph, whose edge flows form a
+        solution to the original problem.
+
+    Raises
+    ------
+    ValueError
+        If the surplus of a component that is not joined to any other component by an
+        edge is nonzero, or if the contracted network could not be balanced.
+    """
+    num_vertices = graph.num_vertices
+    edges = graph.edge_array().astype(np.int64)
+    tails, heads = edges[:, 0], edges[:, 1]
+    surplus = np.asarray(surplus).ravel()
+    cost = np.asarray(cost)
+
+    reverse, has_reverse = _find_edges(tails, heads, heads, tails, num_vertices)
+    free = has_reverse & (cost == 0) & (cost[reverse] == 0)
+
+    # Label the connected components of the subgraph of zero-cost edges.
+    free_tails, free_heads = tails[free], heads[free]
+    free_adjacency = scipy.sparse.coo_array(
+        (np.ones(len(free_tails), dtype=np.int8), (free_tails, free_heads)),
+        shape=(num_vertices, num_vertices),
+    ).tocsr()
+    num_components, labels = scipy.sparse.csgraph.connected_components(
+        free_adjacency, directed=False
+    )
+
+    # Build & solve the contracted network. Edges within a component are dropped, and
+    # so are components that no remaining edge is incident on (e.g. if the whole graph
+    # is a single zero-cost component), since no flow can enter or leave them. Any
+    # surplus of such a component is reported by `_route_within_components()`.
+    crossing = labels[tails] != labels[heads]
+    flow = np.zeros(len(tails), dtype=np.int64)
+    if np.any(crossing):
+        # Every edge has a reverse edge, so each remaining component is both the tail
+        # and the head of some edge and the last one is never isolated.
+        active, contracted_labels = np.unique(
+            labels[np.concatenate([tails[crossing], heads[crossing]])],
+            return_inverse=True,
+        )
+        num_crossing = np.count_nonzero(crossing)
+        contracted_graph, edge_ids = CSRGraph.from_edge_arrays(
+            contracted_labels[:num_crossing],
+            contracted_labels[num_crossing:],
+            num_vertices=len(active),
+        )
+        contracted_cost = np.empty(len(edge_ids), dtype=np.int32)
+        contracted_cost[edge_ids] = cost[crossing]
+        contracted_surplus = np.bincount(
+            labels, weights=surplus, minlength=num_components
+        )[active]
+
+        contracted_network = Network(
+            contracted_graph,
+            contracted_surplus.astype(np.int32),
+            contracted_cost,
+            capacity=1,
+        )
+        primal_dual(contracted_network, maxiter=maxiter)
+        if not contracted_network.is_balanced():
+            raise ValueError("failed to balance the contracted network")
+
+        flow[crossing] = contracted_network.edge_flow_array()[edge_ids]
+
+    # Route the excess left at each vertex (after the flow between components) to the
+    # other vertices of its component.
+    excess = (
+        surplus.astype(np.int64)
+        - np.bincount(tails, weights=flow, minlength=num_vertices).astype(np.int64)
+        + np.bincount(heads, weights=flow, minlength=num_vertices).astype(np.int64)
+    )
+    child, parent, amount = _route_within_components(
+        free_tails, free_heads, labels, excess, num_vertices
+    )
+
+    # Look up the edge from each child to its parent and vice versa. Both are
+    # zero-cost edges, so they must exist.
+    child_to_parent, _ = _find_edges(tails, heads, child, parent, num_vertices)
+    parent_to_child = reverse[child_to_parent]
+
+    upward = amount > 0
+    flow[child_to_parent[upward]] += amount[upward]
+    flow[parent_to_child[~upward]] -= amount[~upward]
+
+    # All of the surplus has been routed, so the network is balanced.
+    network = Network(graph, np.zeros_like(surplus), cost)
+    network.increase_edge_flows(flow)
+    return network
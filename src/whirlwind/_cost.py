@@ -1,9 +1,14 @@
+import functools
 import importlib.resources
-import pickle
+import os
+from concurrent.futures import ThreadPoolExecutor
 
 import numpy as np
+import scipy.interpolate
 import scipy.ndimage
 
+from .spline import load_samples
+
 __all__ = [
     "calc_smooth_phase_gradients",
     "compute_carballo_costs",
@@ -29,52 +34,115 @@ def calc_smooth_phase_gradients(igram):
     return phase_dy_smooth, phase_dx_smooth
 
 
-def load_carballo_pdf_splines():
-    """ """
+@functools.cache
+def load_carballo_pdf_splines() -> tuple[
+    scipy.interpolate.RegularGridInterpolator,
+    scipy.interpolate.RegularGridInterpolator,
+]:
+    """
+    Load the Carballo phase gradient probability density functions.
+
+    Each PDF is tabulated on a regular grid of phase gradient, correlation
+    coefficient, and number of looks, and is interpolated linearly between the grid
+    nodes. Outside of the grid, the PDFs evaluate to NaN. The tables are memory-mapped
+    from the files shipped with the package, and the interpolators are constructed
+    once per process and cached, so the same objects are returned by every call.
+
+    Returns
+    -------
+    pdf0, pdf1 : scipy.interpolate.RegularGridInterpolator
+        The PDFs of the phase gradient in the absence and presence of a phase
+        discontinuity, respectively.
+    """
     files = importlib.resources.files(__package__)
 
-    with files.joinpath("carballo-pdf-0-spline.pkl").open("rb") as f:
-        spline_pdf0 = pickle.load(f)
-    with files.joinpath("carballo-pdf-1-spline.pkl").open("rb") as f:
-        spline_pdf1 = pickle.load(f)
+    def load(name: str) -> scipy.interpolate.RegularGridInterpolator:
+        with importlib.resources.as_file(files.joinpath(name)) as path:
+            knots, samples = load_samples(path)
+        return scipy.interpolate.RegularGridInterpolator(
+            knots, samples, method="linear", bounds_error=False, fill_value=np.nan
+        )
+
+    pdf0 = load("carballo-pdf-0-table.bin")
+    pdf1 = load("carballo-pdf-1-table.bin")
+
+    return pdf0, pdf1
 
-    return spline_pdf0, spline_pdf1
 
+def compute_carballo_costs(
+    igram,
+    corr,
+    nlooks,
+    mask,
+    batch_size: int = 65536,
+    num_threads: int = 0,
+):
+    """
+    Compute phase gradient costs for unwrapping grid.
 
-def compute_carballo_costs(igram, corr, nlooks, mask, batch_size: int = 1000):
-    """Compute phase gradient costs for unwrapping grid."""
+    The costs are scaled by 100 and rounded toward zero to 32-bit integers. Costs
+    outside of the 32-bit range are saturated.
+
+    The PDFs are evaluated in batches of `batch_size` points, which are distributed
+    across `num_threads` threads (all hardware threads if zero). Callers that already
+    compute costs for several tiles or interferograms concurrently should pass
+    ``num_threads=1`` to avoid oversubscription.
+    """
     phase_dy_smooth, phase_dx_smooth = calc_smooth_phase_gradients(igram)
 
     corr = np.asanyarray(corr)
     corr_dy = np.minimum(corr[1:, :], corr[:-1, :])
     corr_dx = np.minimum(corr[:, 1:], corr[:, :-1])
 
-    spline_pdf0, spline_pdf1 = load_carballo_pdf_splines()
+    pdf0, pdf1 = load_carballo_pdf_splines()
+
+    if num_threads == 1:
+        executor = None
+    else:
+        max_workers = num_threads if num_threads > 0 else (os.cpu_count() or 1)
+        executor = ThreadPoolExecutor(max_workers=max_workers)
+
+    def compute_batch(phase_batch, corr_batch, cost_batch):
+        # Compute the negative log-likelihood ratio for the batch in place
+        p1_batch = pdf1((phase_batch, corr_batch, nlooks))
+        p0_batch = pdf0((phase_batch, corr_batch, nlooks))
+        with np.errstate(divide="ignore", invalid="ignore"):
+            cost_batch[...] = -np.log(p1_batch / p0_batch)
 
     def compute_cost(phase_diff, min_corr, batch_size=batch_size):
+        phase_diff = np.ascontiguousarray(phase_diff)
+        min_corr = np.ascontiguousarray(min_corr)
         total_size = phase_diff.size
         costs = np.empty_like(phase_diff)
 
+        batches = []
         for start_idx in range(0, total_size, batch_size):
             end_idx = min(start_idx + batch_size, total_size)
             # Flatten the input arrays for the batch
             phase_batch = phase_diff.ravel()[start_idx:end_idx]
             corr_batch = min_corr.ravel()[start_idx:end_idx]
+            cost_batch = costs.ravel()[start_idx:end_idx]
+            batches.append((phase_batch, corr_batch, cost_batch))
 
-            # Compute probabilities for the batch
-            p1_batch = spline_pdf1((phase_batch, corr_batch, nlooks))
-            p0_batch = spline_pdf0((phase_batch, corr_batch, nlooks))
-
-            # Store results back in original shape
-            costs.ravel()[start_idx:end_idx] = -np.log(p1_batch / p0_batch)
+        if executor is None:
+            for batch in batches:
+                compute_batch(*batch)
+        else:
+            # Evaluate each batch on the thread pool and propagate any exceptions
+            for future in [executor.submit(compute_batch, *b) for b in batches]:
+                future.result()
 
         return costs
 
     # Calculate costs with batched processing
-    cost_up = compute_cost(-phase_dx_smooth, corr_dx)
-    cost_lt = compute_cost(phase_dy_smooth, corr_dy)
-    cost_dn = compute_cost(phase_dx_smooth, corr_dx)
-    cost_rt = compute_cost(-phase_dy_smooth, corr_dy)
+    try:
+        cost_up = compute_cost(-phase_dx_smooth, corr_dx)
+        cost_lt = compute_cost(phase_dy_smooth, corr_dy)
+        cost_dn = compute_cost(phase_dx_smooth, corr_dx)
+        cost_rt = compute_cost(-phase_dy_smooth, corr_dy)
+    finally:
+        if executor is not None:
+            executor.shutdown()
 
     if mask is not None:
         mask = np.asanyarray(mask)
@@ -98,4 +166,8 @@ def compute_carballo_costs(igram, corr, nlooks, mask, batch_size: int = 1000):
         )
     )
     cost[np.isnan(cost)] = 0.0
-    return (100.0 * cost).astype(np.int32)
+    cost *= 100.0
+
+    info = np.iinfo(np.int32)
+    np.clip(cost, info.min, info.max, out=cost)
+    return cost.astype(np.int32)
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+
+namespace whirlwind::bindings {
+
+// Invoke `func(std::type_identity<Graph>(), suffix)` for each `RectangularGridGraph`
+// with an explicit 32- or 64-bit index type, where `suffix` is appended to the names of
+// the corresponding Python classes. A variant whose index type coincides with the
+// default `RectangularGridGraph<>` is skipped, since it is already bound under the
+// default name.
+template<class Func>
+void
+for_each_grid_graph_index_variant(Func&& func)
+{
+    using GridGraph_u32 = RectangularGridGraph<1, std::uint32_t>;
+    using GridGraph_u64 = RectangularGridGraph<1, std::uint64_t>;
+
+    if constexpr (!std::is_same_v<GridGraph_u32, RectangularGridGraph<>>) {
+        func(std::type_identity<GridGraph_u32>(), std::string("_u32"));
+    }
+    if constexpr (!std::is_same_v<GridGraph_u64, RectangularGridGraph<>>) {
+        func(std::type_identity<GridGraph_u64>(), std::string("_u64"));
+    }
+}
+
+} // namespace whirlwind::bindings
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <whirlwind/common/stddef.hpp>
+
+namespace whirlwind::bindings {
+
+// Get the number of worker threads to use. A value of zero selects the number of
+// concurrent threads supported by the hardware.
+[[nodiscard]] inline auto
+get_num_threads(Size num_threads = 0) -> Size
+{
+    if (num_threads == 0) {
+        num_threads = static_cast<Size>(std::thread::hardware_concurrency());
+    }
+    return std::max(num_threads, Size{1});
+}
+
+// A fixed set of worker threads that run submitted tasks in FIFO order.
+class ThreadPool {
+public:
+    explicit ThreadPool(Size num_workers)
+    {
+        workers_.reserve(num_workers);
+        for (Size i = 0; i < num_workers; ++i) {
+            workers_.emplace_back([this]() { run(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    auto
+    operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+    [[nodiscard]] auto
+    num_workers() const noexcept -> Size
+    {
+        return workers_.size();
+    }
+
+    void
+    submit(std::function<void()> task)
+    {
+        {
+            const auto lock = std::lock_guard(mutex_);
+            tasks_.push_back(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void
+    run()
+    {
+        while (true) {
+            auto task = std::function<void()>();
+            {
+                auto lock = std::unique_lock(mutex_);
+                cv_.wait(lock, [this]() { return !tasks_.empty(); });
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> workers_;
+};
+
+// Get the thread pool shared by all parallel loops in this module. It is created on
+// first use with one worker fewer than the number of hardware threads, since the
+// calling thread also takes part in each loop. The pool is never destroyed, so that
+// its workers are not joined during static destruction at interpreter exit.
+[[nodiscard]] inline auto
+get_thread_pool() -> ThreadPool&
+{
+    static auto* const pool = new ThreadPool(get_num_threads() - 1);
+    return *pool;
+}
+
+// Split the index range [0, size) into contiguous chunks and call `func(begin, end)` on
+// each chunk concurrently, using up to `num_threads` threads of the shared pool
+// including the calling thread.
+//
+// Chunks are claimed dynamically, and the calling thread processes chunks too until
+// none are left, so the loop completes even if every pool worker is busy (e.g. when
+// `parallel_for` is called from within another parallel loop, or from many Python
+// threads at once). An exception thrown by `func` is rethrown in the calling thread
+// once all chunks have finished.
+template<class Func>
+void
+parallel_for(Size size, Size num_threads, Func&& func)
+{
+    num_threads = std::min(get_num_threads(num_threads), std::max(size, Size{1}));
+    if (num_threads == 1) {
+        func(Size{0}, size);
+        return;
+    }
+
+    const auto chunk_size = (size + num_threads - 1) / num_threads;
+    const auto num_chunks = (size + chunk_size - 1) / chunk_size;
+
+    struct State {
+        std::atomic<Size> next_chunk = 0;
+        std::mutex mutex;
+        std::condition_variable cv;
+        Size num_done = 0;
+        std::exception_ptr error;
+    };
+    const auto state = std::make_shared<State>();
+
+    // Helper tasks may start after all chunks have been claimed and the loop has
+    // returned, so they must only touch `func` after successfully claiming a chunk.
+    const auto process_chunks = [state, &func, size, chunk_size, num_chunks]() {
+        while (true) {
+            const auto chunk = state->next_chunk.fetch_add(1);
+            if (chunk >= num_chunks) {
+                return;
+            }
+
+            const auto begin = chunk * chunk_size;
+            const auto end = std::min(begin + chunk_size, size);
+            auto error = std::exception_ptr();
+            try {
+                func(begin, end);
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            const auto lock = std::lock_guard(state->mutex);
+            if (error && !state->error) {
+                state->error = std::move(error);
+            }
+            if (++state->num_done == num_chunks) {
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    auto& pool = get_thread_pool();
+    const auto num_helpers = std::min(num_threads - 1, pool.num_workers());
+    for (Size i = 0; i < num_helpers; ++i) {
+        pool.submit(process_chunks);
+    }
+    process_chunks();
+
+    auto lock = std::unique_lock(state->mutex);
+    state->cv.wait(lock, [&]() { return state->num_done == num_chunks; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+} // namespace whirlwind::bindings
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <utility>
+#include <vector>
 
 #include <nanobind/ndarray.h>
 
@@ -25,6 +26,9 @@ using PyContiguousArray2D = PyContiguousArrayND<T, 2>;
 template<class T>
 using PyContiguousArray3D = PyContiguousArrayND<T, 3>;
 
+template<class T>
+using NumPyArray = nb::ndarray<T, nb::numpy>;
+
 template<class T, std::size_t Rank>
 using NumPyArrayND = nb::ndarray<T, nb::numpy, nb::ndim<Rank>>;
 
@@ -91,4 +95,15 @@ to_numpy_array(Array3D<T, Container> arr) -> NumPyArray3D<T>
                            std::move(owner));
 }
 
+template<class T, class Allocator>
+[[nodiscard]] auto
+to_numpy_array(std::vector<T, Allocator> arr, const std::vector<std::size_t>& shape)
+        -> NumPyArray<T>
+{
+    auto out = new auto(std::move(arr));
+    auto owner = nb::capsule(
+            out, [](void* p) noexcept { delete static_cast<decltype(out)>(p); });
+    return NumPyArray<T>(out->data(), shape.size(), shape.data(), std::move(owner));
+}
+
 } // namespace whirlwind::bindings
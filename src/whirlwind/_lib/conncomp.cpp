@@ -0,0 +1,46 @@
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <nanobind/nanobind.h>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
+
+#include "array.hpp"
+#include "conncomp.hpp"
+
+namespace whirlwind::bindings {
+
+namespace nb = nanobind;
+using namespace nb::literals;
+
+void
+conncomp(nb::module_& m)
+{
+    m.def(
+            "label_connected_components",
+            [](const PyContiguousArray2D<const bool>& connected_x,
+               const PyContiguousArray2D<const bool>& connected_y, Size min_size,
+               Size num_threads) {
+                const auto num_rows = static_cast<Size>(connected_x.shape(0));
+                const auto num_cols = static_cast<Size>(connected_y.shape(1));
+                WHIRLWIND_ASSERT(num_rows >= 1 && num_cols >= 1);
+                WHIRLWIND_ASSERT(connected_x.shape(1) == num_cols - 1);
+                WHIRLWIND_ASSERT(connected_y.shape(0) == num_rows - 1);
+
+                auto labels = [&]() {
+                    [[maybe_unused]] const nb::gil_scoped_release nogil;
+                    auto out = std::vector<std::uint32_t>(num_rows * num_cols);
+                    label_connected_components(connected_x.data(), connected_y.data(),
+                                               num_rows, num_cols, min_size,
+                                               out.data(), num_threads);
+                    return out;
+                }();
+
+                return to_numpy_array(std::move(labels), {num_rows, num_cols});
+            },
+            "connected_x"_a, "connected_y"_a, "min_size"_a = 1, "num_threads"_a = 0);
+}
+
+} // namespace whirlwind::bindings
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
+
+#include "parallel.hpp"
+
+namespace whirlwind::bindings {
+
+// A disjoint-set forest over pixel indices. Sets are joined by linking the root with
+// the larger index to the root with the smaller index, and paths are shortened by path
+// halving during `find()`.
+class PixelDisjointSets {
+public:
+    explicit PixelDisjointSets(std::uint32_t* parent, Size size) : parent_(parent)
+    {
+        for (Size i = 0; i < size; ++i) {
+            parent_[i] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    [[nodiscard]] auto
+    find(std::uint32_t i) noexcept -> std::uint32_t
+    {
+        while (parent_[i] != i) {
+            parent_[i] = parent_[parent_[i]];
+            i = parent_[i];
+        }
+        return i;
+    }
+
+    // Like `find()`, but without path halving, so it may be called concurrently from
+    // multiple threads as long as no other thread is modifying the forest.
+    [[nodiscard]] auto
+    find_root(std::uint32_t i) const noexcept -> std::uint32_t
+    {
+        while (parent_[i] != i) {
+            i = parent_[i];
+        }
+        return i;
+    }
+
+    void
+    unite(std::uint32_t i, std::uint32_t j) noexcept
+    {
+        i = find(i);
+        j = find(j);
+        if (i < j) {
+            parent_[j] = i;
+        } else if (j < i) {
+            parent_[i] = j;
+        }
+    }
+
+private:
+    std::uint32_t* parent_;
+};
+
+// Label the connected components of a grid of pixels.
+//
+// Horizontally (vertically) adjacent pixels are connected if `connected_x`
+// (`connected_y`) is true for the pair. `connected_x` is a row-major
+// (num_rows, num_cols - 1) array, and `connected_y` is a row-major
+// (num_rows - 1, num_cols) array. When labeling the unwrapped phase, the caller
+// excludes pairs that are crossed by flow in the unwrapping solution.
+//
+// Components with at least `min_size` pixels are labeled 1, 2, ..., in order of
+// decreasing size. All other pixels are labeled 0. The labels are written to `out`, a
+// row-major (num_rows, num_cols) array.
+//
+// Pixels are first joined within horizontal strips of rows in parallel. The strips are
+// then joined along their shared boundaries, and finally each pixel is relabeled in
+// parallel.
+inline void
+label_connected_components(const bool* connected_x,
+                           const bool* connected_y,
+                           Size num_rows,
+                           Size num_cols,
+                           Size min_size,
+                           std::uint32_t* out,
+                           Size num_threads = 0)
+{
+    const auto num_pixels = num_rows * num_cols;
+    WHIRLWIND_ASSERT(num_pixels < std::numeric_limits<std::uint32_t>::max());
+
+    const auto is_connected_x = [&](Size i, Size j) {
+        return connected_x[i * (num_cols - 1) + j];
+    };
+    const auto is_connected_y = [&](Size i, Size j) {
+        return connected_y[i * num_cols + j];
+    };
+
+    // The disjoint-set forest is stored in the output array.
+    auto sets = PixelDisjointSets(out, num_pixels);
+
+    // Join pixels within each strip. Each thread only touches the pixels in its own
+    // strip, so no synchronization is needed.
+    auto is_strip_end = std::vector<char>(num_rows, 0);
+    parallel_for(num_rows, num_threads, [&](Size begin, Size end) {
+        if (begin == end) {
+            return;
+        }
+        for (Size i = begin; i < end; ++i) {
+            for (Size j = 0; j + 1 < num_cols; ++j) {
+                if (is_connected_x(i, j)) {
+                    sets.unite(static_cast<std::uint32_t>(i * num_cols + j),
+                               static_cast<std::uint32_t>(i * num_cols + j + 1));
+                }
+            }
+            if (i + 1 < end) {
+                for (Size j = 0; j < num_cols; ++j) {
+                    if (is_connected_y(i, j)) {
+                        sets.unite(static_cast<std::uint32_t>(i * num_cols + j),
+                                   static_cast<std::uint32_t>((i + 1) * num_cols + j));
+                    }
+                }
+            }
+        }
+        is_strip_end[end - 1] = 1;
+    });
+
+    // Join the strips along their boundaries.
+    for (Size i = 0; i + 1 < num_rows; ++i) {
+        if (!is_strip_end[i]) {
+            continue;
+        }
+        for (Size j = 0; j < num_cols; ++j) {
+            if (is_connected_y(i, j)) {
+                sets.unite(static_cast<std::uint32_t>(i * num_cols + j),
+                           static_cast<std::uint32_t>((i + 1) * num_cols + j));
+            }
+        }
+    }
+
+    // Find the root of every pixel. Roots are never modified in this step, so each
+    // thread sees a consistent forest regardless of the order of the writes.
+    auto roots = std::vector<std::uint32_t>(num_pixels);
+    parallel_for(num_pixels, num_threads, [&](Size begin, Size end) {
+        for (Size p = begin; p < end; ++p) {
+            roots[p] = sets.find_root(static_cast<std::uint32_t>(p));
+        }
+    });
+
+    // Count the size of each component, then order the components by decreasing size.
+    // The count of each root is overwritten by its label.
+    auto& label_of = roots;
+    auto sizes = std::vector<std::pair<Size, std::uint32_t>>();
+    {
+        auto count = std::vector<std::uint32_t>(num_pixels, 0);
+        for (Size p = 0; p < num_pixels; ++p) {
+            ++count[roots[p]];
+        }
+        for (Size p = 0; p < num_pixels; ++p) {
+            if (roots[p] == p && count[p] >= min_size) {
+                sizes.emplace_back(count[p], static_cast<std::uint32_t>(p));
+            }
+        }
+        std::copy(roots.begin(), roots.end(), out);
+    }
+    std::sort(sizes.begin(), sizes.end(), [](const auto& a, const auto& b) {
+        return (a.first != b.first) ? (a.first > b.first) : (a.second < b.second);
+    });
+
+    std::fill(label_of.begin(), label_of.end(), std::uint32_t{0});
+    for (Size k = 0; k < sizes.size(); ++k) {
+        label_of[sizes[k].second] = static_cast<std::uint32_t>(k + 1);
+    }
+
+    parallel_for(num_pixels, num_threads, [&](Size begin, Size end) {
+        for (Size p = begin; p < end; ++p) {
+            out[p] = label_of[out[p]];
+        }
+    });
+}
+
+} // namespace whirlwind::bindings
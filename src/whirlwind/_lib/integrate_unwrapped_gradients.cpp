@@ -1,4 +1,6 @@
 #include <cstdint>
+#include <string>
+#include <type_traits>
 #include <utility>
 
 #include <nanobind/nanobind.h>
@@ -12,6 +14,7 @@
 #include <whirlwind/network/unit_capacity.hpp>
 
 #include "array.hpp"
+#include "index_types.hpp"
 
 namespace whirlwind::bindings {
 
@@ -83,8 +86,12 @@ template<class T>
 void
 integrate_unwrapped_gradients(nb::module_& m)
 {
-    using Graph = RectangularGridGraph<>;
-    integrate_unwrapped_gradients<T, Graph>(m);
+    integrate_unwrapped_gradients<T, RectangularGridGraph<>>(m);
+
+    for_each_grid_graph_index_variant(
+            [&]<class Graph>(std::type_identity<Graph>, const std::string&) {
+                integrate_unwrapped_gradients<T, Graph>(m);
+            });
 }
 
 void
@@ -10,8 +10,10 @@ namespace whirlwind::bindings {
 namespace nb = nanobind;
 
 // clang-format off
+void conncomp(nb::module_&);
 void residue(nb::module_&);
 void integrate_unwrapped_gradients(nb::module_&);
+void unwrap_stack(nb::module_&);
 // clang-format on
 
 } // namespace whirlwind::bindings
@@ -25,6 +27,8 @@ NB_MODULE(_lib, m)
     m.attr("__version_tuple__") =
             std::pair(WHIRLWIND_VERSION_MAJOR, WHIRLWIND_VERSION_MINOR);
 
+    whirlwind::bindings::conncomp(m);
     whirlwind::bindings::residue(m);
     whirlwind::bindings::integrate_unwrapped_gradients(m);
+    whirlwind::bindings::unwrap_stack(m);
 }
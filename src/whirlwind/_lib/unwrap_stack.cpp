@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <nanobind/nanobind.h>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/ndspan.hpp>
+#include <whirlwind/common/stddef.hpp>
+#include <whirlwind/common/vector.hpp>
+#include <whirlwind/graph/dial.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
+#include <whirlwind/integrate_unwrapped_gradients.hpp>
+#include <whirlwind/logging/null_logger.hpp>
+#include <whirlwind/network/network.hpp>
+#include <whirlwind/network/primal_dual.hpp>
+#include <whirlwind/network/residual_graph_traits.hpp>
+#include <whirlwind/network/unit_capacity.hpp>
+#include <whirlwind/residue.hpp>
+
+#include "array.hpp"
+#include "index_types.hpp"
+#include "parallel.hpp"
+
+namespace whirlwind::bindings {
+
+namespace nb = nanobind;
+using namespace nb::literals;
+
+template<class T, class Graph>
+void
+unwrap_stack(nb::module_& m)
+{
+    using Cost = std::int32_t;
+    using Flow = std::int32_t;
+    using Mixin = UnitCapacityMixin<Graph, Flow, Vector>;
+    using Network = Network<Graph, Cost, Flow, Vector, Mixin>;
+    using ResidualGraph = ResidualGraphTraits<Graph>::type;
+    using Dijkstra = Dial<Cost, ResidualGraph>;
+
+    m.def(
+            "unwrap_stack",
+            [](const PyContiguousArray3D<const T>& wrapped_phase,
+               const PyContiguousArray2D<const Cost>& cost, const Graph& graph,
+               const PyContiguousArray3D<T>& out, Size maxiter, Size num_threads) {
+                const auto count = static_cast<Size>(wrapped_phase.shape(0));
+                const auto num_rows = static_cast<Size>(wrapped_phase.shape(1));
+                const auto num_cols = static_cast<Size>(wrapped_phase.shape(2));
+                const auto num_pixels = num_rows * num_cols;
+                const auto num_costs = static_cast<Size>(cost.shape(1));
+
+                WHIRLWIND_ASSERT(cost.shape(0) == count);
+                WHIRLWIND_ASSERT(out.shape(0) == count);
+                WHIRLWIND_ASSERT(out.shape(1) == num_rows);
+                WHIRLWIND_ASSERT(out.shape(2) == num_cols);
+
+                const auto* phase_data = wrapped_phase.data();
+                const auto* cost_data = cost.data();
+                auto* out_data = out.data();
+
+                [[maybe_unused]] const nb::gil_scoped_release nogil;
+
+                // The time to solve each network varies with the number and layout of
+                // its residues, so interferograms are handed out to the worker threads
+                // one at a time rather than in fixed chunks.
+                auto next = std::atomic<Size>(0);
+                const auto num_workers = std::min(get_num_threads(num_threads), count);
+                parallel_for(num_workers, num_workers, [&](Size, Size) {
+                    // Reused for every interferogram processed by this thread.
+                    auto surplus = std::vector<Flow>();
+
+                    for (auto i = next++; i < count; i = next++) {
+                        const auto phase = Span2D<const T>(phase_data + i * num_pixels,
+                                                           num_rows, num_cols);
+                        const auto residue = whirlwind::residue(phase);
+                        WHIRLWIND_ASSERT(residue.size() == graph.num_vertices());
+
+                        surplus.assign(residue.data(), residue.data() + residue.size());
+                        const auto cost_span = std::span(cost_data + i * num_costs,
+                                                         num_costs);
+
+                        auto network = Network(graph, std::span<const Flow>(surplus),
+                                               cost_span);
+                        whirlwind::primal_dual<Dijkstra, NullLogger>(network, maxiter);
+
+                        const auto unwrapped = whirlwind::integrate_unwrapped_gradients(
+                                phase, network);
+                        std::copy_n(unwrapped.data(), num_pixels,
+                                    out_data + i * num_pixels);
+                    }
+                });
+            },
+            "wrapped_phase"_a, "cost"_a, "graph"_a, "out"_a, "maxiter"_a = 8,
+            "num_threads"_a = 0);
+}
+
+template<class Graph>
+void
+unwrap_stack(nb::module_& m)
+{
+    unwrap_stack<float, Graph>(m);
+    unwrap_stack<double, Graph>(m);
+}
+
+void
+unwrap_stack(nb::module_& m)
+{
+    unwrap_stack<RectangularGridGraph<>>(m);
+
+    for_each_grid_graph_index_variant(
+            [&]<class Graph>(std::type_identity<Graph>, const std::string&) {
+                unwrap_stack<Graph>(m);
+            });
+}
+
+} // namespace whirlwind::bindings
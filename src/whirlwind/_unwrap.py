@@ -1,35 +1,744 @@
+import itertools
+import os
+from concurrent.futures import FIRST_COMPLETED, ThreadPoolExecutor, wait
+
 import numpy as np
 from numpy.typing import ArrayLike
 
+from ._contract import primal_dual_contracted
 from ._cost import compute_carballo_costs
-from ._lib import integrate_unwrapped_gradients
+from ._lib import integrate_unwrapped_gradients, label_connected_components
 from ._lib import residue as get_residues
-from .graph import RectangularGridGraph
+from ._lib import unwrap_stack as solve_stack
+from .graph import CSRGraph, RectangularGridGraph
 from .network import Network, primal_dual
 
 __all__ = [
     "unwrap",
+    "unwrap_stack",
 ]
 
 
+def _unwrap_tile(  # type: ignore[no-untyped-def]
+    igram,
+    corr,
+    nlooks,
+    mask,
+    contract_zero_cost=False,
+    num_threads=0,
+    conncomp_cost_threshold=None,
+):
+    """
+    Unwrap an interferogram as a single network.
+
+    Returns the unwrapped phase and, if `conncomp_cost_threshold` is not None, the
+    connectivity of each pair of adjacent pixels (see `_get_connectivity()`), or None
+    otherwise.
+    """
+    phase = np.angle(igram)
+
+    residue = get_residues(phase)
+
+    surplus = residue.flatten()
+    cost = compute_carballo_costs(igram, corr, nlooks, mask, num_threads=num_threads)
+
+    # Narrow indices halve the memory used by the solver's per-arc and per-node index
+    # arrays, and are used whenever they can index every arc of the network.
+    graph = RectangularGridGraph(*residue.shape, index_dtype="auto")
+    if contract_zero_cost:
+        network = primal_dual_contracted(graph, surplus, cost, maxiter=8)
+    else:
+        network = Network(graph, surplus, cost, capacity=1)
+        primal_dual(network, maxiter=8)
+
+    unwrapped = integrate_unwrapped_gradients(phase, network._impl)
+
+    connectivity = None
+    if conncomp_cost_threshold is not None:
+        flow = network.edge_flow_array()
+        connectivity = _get_connectivity(
+            cost, flow, unwrapped.shape, conncomp_cost_threshold
+        )
+        del flow
+
+    # Release the network as soon as its flows have been integrated, rather than when
+    # the caller is done with the tile.
+    del network, cost
+    return unwrapped, connectivity
+
+
+def _get_connectivity(  # type: ignore[no-untyped-def]
+    cost, flow, shape, threshold
+):
+    """
+    Find the pairs of adjacent pixels that are connected in the unwrapped solution.
+
+    A pair is connected if the costs of the arcs that separate it exceed `threshold` in
+    both directions, and if neither arc carries any flow, i.e. the unwrapping solution
+    has no cycle discontinuity between the two pixels.
+
+    `cost` & `flow` are the cost and flow of each edge of the unwrapping network, laid
+    out as returned by `compute_carballo_costs()` for an interferogram with the
+    specified shape. Returns two boolean arrays, for horizontally- and
+    vertically-adjacent pairs, respectively, with shapes (M, N-1) and (M-1, N).
+    """
+    nrows, ncols = shape
+    size_x = nrows * (ncols + 1)
+    size_y = (nrows + 1) * ncols
+    splits = np.cumsum([size_x, size_y, size_x])
+    cost_up, cost_lt, cost_dn, cost_rt = np.split(cost, splits)
+    flow_up, flow_lt, flow_dn, flow_rt = np.split(flow, splits)
+
+    # Edge flows are non-negative, so their sum is zero only if both arcs are empty.
+    cost_x = np.minimum(cost_up, cost_dn).reshape(nrows, ncols + 1)[:, 1:-1]
+    cost_y = np.minimum(cost_lt, cost_rt).reshape(nrows + 1, ncols)[1:-1, :]
+    flow_x = (flow_up + flow_dn).reshape(nrows, ncols + 1)[:, 1:-1]
+    flow_y = (flow_lt + flow_rt).reshape(nrows + 1, ncols)[1:-1, :]
+    return (cost_x > threshold) & (flow_x == 0), (cost_y > threshold) & (flow_y == 0)
+
+
+def _get_tile_bounds(
+    length: int, tile_length: int, overlap: int
+) -> list[tuple[int, int]]:
+    """
+    Split an axis into overlapping tiles.
+
+    Consecutive tiles overlap by at least `overlap` samples. The last tile is aligned
+    with the end of the axis, so it may overlap its predecessor by more.
+    """
+    if length <= tile_length:
+        return [(0, length)]
+    starts = list(range(0, length - tile_length, tile_length - overlap))
+    starts.append(length - tile_length)
+    return [(start, start + tile_length) for start in starts]
+
+
+def _get_core_bounds(tile_bounds: list[tuple[int, int]]) -> list[tuple[int, int]]:
+    """
+    Get the disjoint region of an axis that is assigned to each tile in the output.
+
+    Each overlap between consecutive tiles is split at its midpoint.
+    """
+    cuts = [(b[0] + a[1]) // 2 for a, b in zip(tile_bounds, tile_bounds[1:])]
+    cuts = [tile_bounds[0][0]] + cuts + [tile_bounds[-1][1]]
+    return list(zip(cuts[:-1], cuts[1:]))
+
+
+def _estimate_tile_offset(a: np.ndarray, b: np.ndarray) -> tuple[int, int]:
+    """
+    Estimate the relative cycle offset of two tiles from their overlap.
+
+    Returns the integer number of cycles that must be added to `b` (relative to `a`)
+    such that the two unwrapped phase arrays agree, along with a weight in [1, 1001]
+    that measures the fraction of samples in the overlap that agree on that offset.
+    """
+    cycles = np.rint((a - b) / (2.0 * np.pi))
+    cycles = cycles[np.isfinite(cycles)]
+    if cycles.size == 0:
+        return 0, 1
+    offset = int(np.rint(np.median(cycles)))
+    agreement = np.count_nonzero(cycles == offset) / cycles.size
+    return offset, 1 + int(1000.0 * agreement)
+
+
+def _reconcile_tile_offsets(
+    dh: np.ndarray, dv: np.ndarray, wh: np.ndarray, wv: np.ndarray
+) -> np.ndarray:
+    """
+    Compute a consistent cycle offset for each tile from pairwise tile offsets.
+
+    `dh[r,c]` is the estimated offset of tile (r,c+1) relative to tile (r,c), and
+    `dv[r,c]` is the estimated offset of tile (r+1,c) relative to tile (r,c). `wh` &
+    `wv` are the corresponding weights.
+
+    The pairwise offsets around a loop of four adjacent tiles should sum to zero. Loops
+    where they don't are residues of the (coarse) tile grid. These are resolved in the
+    same way as in the per-tile problem: by solving a minimum cost flow problem on the
+    dual graph of the tile grid, which finds the minimum-weight set of corrections to
+    the pairwise offsets that eliminates all residues. The corrected offsets are then
+    integrated starting from the first tile.
+
+    Returns an array with the offset, in cycles, of each tile.
+    """
+    nrows = dv.shape[0] + 1
+    ncols = dh.shape[1] + 1
+
+    residue = dh[:-1, :] + dv[:, 1:] - dh[1:, :] - dv[:, :-1]
+    if np.any(residue):
+        dh, dv = dh.copy(), dv.copy()
+        eh, ev = _get_tile_offset_corrections(residue, wh, wv)
+        dh += eh
+        dv += ev
+
+    first_row = np.concatenate([[0], np.cumsum(dh[0])])
+    offsets = np.empty((nrows, ncols), dtype=np.int64)
+    offsets[0] = first_row
+    offsets[1:] = first_row + np.cumsum(dv, axis=0)
+    return offsets
+
+
+def _get_tile_offset_corrections(
+    residue: np.ndarray, wh: np.ndarray, wv: np.ndarray
+) -> tuple[np.ndarray, np.ndarray]:
+    """
+    Find the minimum-weight corrections to the pairwise tile offsets that eliminate all
+    residues in the tile grid.
+
+    Each node of the network is a loop of four adjacent tiles, plus one extra "ground"
+    node for the region outside of the tile grid. Each pair of adjacent tiles separates
+    two nodes and is represented by an arc in each direction between them, whose cost
+    is the weight of the pair. The surplus of each node is its residue.
+    """
+    nrows, ncols = residue.shape[0] + 1, residue.shape[1] + 1
+    num_loops = residue.size
+    ground = num_loops
+
+    def loop_index(r, c, valid):  # type: ignore[no-untyped-def]
+        return np.where(valid, r * (ncols - 1) + c, ground)
+
+    # The loops on the positive & negative side of each horizontally-adjacent pair. A
+    # pair (r,c)-(r,c+1) is the top side of loop (r,c) and the bottom side of loop
+    # (r-1,c).
+    r, c = np.indices(wh.shape)
+    h_pos = loop_index(r, c, r < nrows - 1)
+    h_neg = loop_index(r - 1, c, r > 0)
+
+    # Likewise for vertically-adjacent pairs. A pair (r,c)-(r+1,c) is the right side of
+    # loop (r,c-1) and the left side of loop (r,c).
+    r, c = np.indices(wv.shape)
+    v_pos = loop_index(r, c - 1, c > 0)
+    v_neg = loop_index(r, c, c < ncols - 1)
+
+    pos = np.concatenate([h_pos.ravel(), v_pos.ravel()])
+    neg = np.concatenate([h_neg.ravel(), v_neg.ravel()])
+    weight = np.concatenate([wh.ravel(), wv.ravel()]).astype(np.int32)
+    num_pairs = len(weight)
+
+    tails = np.concatenate([pos, neg])
+    heads = np.concatenate([neg, pos])
+    graph, edge_ids = CSRGraph.from_edge_arrays(tails, heads)
+
+    cost = np.empty(2 * num_pairs, dtype=np.int32)
+    cost[edge_ids] = np.concatenate([weight, weight])
+
+    surplus = np.concatenate([residue.ravel(), [-residue.sum()]]).astype(np.int32)
+
+    network = Network(graph, surplus, cost)
+    primal_dual(network)
+    if not network.is_balanced():
+        raise RuntimeError("failed to reconcile tile offsets")
+
+    flow = network.edge_flow_array()[edge_ids].astype(np.int64)
+
+    # Flow from the negative to the positive side of a pair increases its offset.
+    correction = flow[num_pairs:] - flow[:num_pairs]
+    eh = correction[: wh.size].reshape(wh.shape)
+    ev = correction[wh.size :].reshape(wv.shape)
+    return eh, ev
+
+
+def _multilook(arr: np.ndarray, looks: tuple[int, int]) -> np.ndarray:
+    """
+    Average non-overlapping blocks of an array.
+
+    Trailing rows & columns that don't fill a whole block are discarded. The input is
+    read in bands of rows, so memory-mapped inputs are never loaded all at once.
+    """
+    ly, lx = looks
+    nrows, ncols = arr.shape[0] // ly, arr.shape[1] // lx
+    dtype = np.result_type(arr.dtype, np.float32)
+    out = np.empty((nrows, ncols), dtype=dtype)
+
+    band = max(1, 1024 // ly)
+    for i in range(0, nrows, band):
+        j = min(i + band, nrows)
+        block = np.asarray(arr[i * ly : j * ly, : ncols * lx], dtype=dtype)
+        out[i:j] = block.reshape(j - i, ly, ncols, lx).mean(axis=(1, 3))
+    return out
+
+
+def _upsample(
+    coarse: np.ndarray,
+    looks: tuple[int, int],
+    rows: tuple[int, int],
+    cols: tuple[int, int],
+) -> np.ndarray:
+    """
+    Get a full-resolution block of a multilooked array by nearest-neighbor
+    interpolation.
+
+    Rows & columns beyond the extent of the multilooked array (which were discarded by
+    `_multilook()`) are taken from the nearest block.
+    """
+    ly, lx = looks
+    ri = np.minimum(np.arange(*rows) // ly, coarse.shape[0] - 1)
+    ci = np.minimum(np.arange(*cols) // lx, coarse.shape[1] - 1)
+    return coarse[np.ix_(ri, ci)]
+
+
+def _unwrap_coarse(  # type: ignore[no-untyped-def]
+    igram, corr, nlooks, mask, looks, contract_zero_cost
+):
+    """Unwrap a multilooked copy of the interferogram."""
+    igram_ml = _multilook(igram, looks)
+    corr_ml = _multilook(corr, looks)
+    if min(igram_ml.shape) < 2:
+        raise ValueError("coarse_looks is too large for the size of the interferogram")
+
+    # A block is masked out only if all of its pixels are.
+    mask_ml = None if mask is None else (_multilook(mask, looks) == 1.0)
+
+    nlooks_ml = nlooks * looks[0] * looks[1]
+    unwrapped, _ = _unwrap_tile(
+        igram_ml, corr_ml, nlooks_ml, mask_ml, contract_zero_cost
+    )
+    return unwrapped
+
+
+def _apply_tile_offsets(  # type: ignore[no-untyped-def]
+    strips, out, row_cores, col_cores
+):
+    """Estimate, reconcile and apply the cycle offset of each tile."""
+    nrows, ncols = len(row_cores), len(col_cores)
+
+    dh = np.zeros((nrows, ncols - 1), dtype=np.int64)
+    wh = np.ones((nrows, ncols - 1), dtype=np.int64)
+    for r in range(nrows):
+        for c in range(ncols - 1):
+            dh[r, c], wh[r, c] = _estimate_tile_offset(
+                strips[r, c]["right"], strips[r, c + 1]["left"]
+            )
+
+    dv = np.zeros((nrows - 1, ncols), dtype=np.int64)
+    wv = np.ones((nrows - 1, ncols), dtype=np.int64)
+    for r in range(nrows - 1):
+        for c in range(ncols):
+            dv[r, c], wv[r, c] = _estimate_tile_offset(
+                strips[r, c]["bottom"], strips[r + 1, c]["top"]
+            )
+
+    offsets = _reconcile_tile_offsets(dh, dv, wh, wv)
+    for r in range(nrows):
+        for c in range(ncols):
+            if offsets[r, c] != 0:
+                (y0, y1), (x0, x1) = row_cores[r], col_cores[c]
+                out[y0:y1, x0:x1] += 2.0 * np.pi * offsets[r, c]
+
+
+def _unwrap_tiled(  # type: ignore[no-untyped-def]
+    igram,
+    corr,
+    nlooks,
+    mask,
+    tile_shape,
+    tile_overlap,
+    num_threads,
+    coarse_looks=None,
+    contract_zero_cost=False,
+    conncomp=None,
+    out=None,
+):
+    igram = np.asanyarray(igram)
+    corr = np.asanyarray(corr)
+    if mask is not None:
+        mask = np.asanyarray(mask)
+
+    # With a coarse reference, the cycle offset of each tile is taken from the coarse
+    # solution instead of being reconciled from the tile overlaps. The tiles themselves
+    # are solved from scratch, exactly as in plain tiled mode.
+    coarse = None
+    if coarse_looks is not None:
+        coarse = _unwrap_coarse(
+            igram, corr, nlooks, mask, coarse_looks, contract_zero_cost
+        )
+
+    row_bounds = _get_tile_bounds(igram.shape[0], tile_shape[0], tile_overlap)
+    col_bounds = _get_tile_bounds(igram.shape[1], tile_shape[1], tile_overlap)
+    row_cores = _get_core_bounds(row_bounds)
+    col_cores = _get_core_bounds(col_bounds)
+    nrows, ncols = len(row_bounds), len(col_bounds)
+
+    # Each tile's core is written to `out` as soon as the tile is solved, and the tile
+    # offsets are then applied one core at a time, so `out` may be memory-mapped.
+    if out is None:
+        phase_dtype = np.angle(np.zeros(1, dtype=igram.dtype)).dtype
+        out = np.empty(igram.shape, dtype=phase_dtype)
+
+    # If connected components are requested, the connectivity of each pair of adjacent
+    # pixels is taken from the tile whose core contains the first pixel.
+    if conncomp is not None:
+        height, width = igram.shape
+        connected_x = np.empty((height, width - 1), dtype=np.bool_)
+        connected_y = np.empty((height - 1, width), dtype=np.bool_)
+
+    def solve_tile(r, c):  # type: ignore[no-untyped-def]
+        (r0, r1), (c0, c1) = row_bounds[r], col_bounds[c]
+        tile = np.s_[r0:r1, c0:c1]
+        unwrapped, connectivity = _unwrap_tile(
+            igram[tile],
+            corr[tile],
+            nlooks,
+            None if mask is None else mask[tile],
+            contract_zero_cost,
+            # Tiles are already solved concurrently.
+            num_threads=1,
+            conncomp_cost_threshold=None if conncomp is None else conncomp[0],
+        )
+
+        if coarse is not None:
+            reference = _upsample(coarse, coarse_looks, (r0, r1), (c0, c1))
+            offset, _ = _estimate_tile_offset(reference, unwrapped)
+            unwrapped += 2.0 * np.pi * offset
+
+        (y0, y1), (x0, x1) = row_cores[r], col_cores[c]
+        out[y0:y1, x0:x1] = unwrapped[y0 - r0 : y1 - r0, x0 - c0 : x1 - c0]
+
+        if connectivity is not None:
+            cx, cy = connectivity
+            x2, y2 = min(x1, width - 1), min(y1, height - 1)
+            connected_x[y0:y1, x0:x2] = cx[y0 - r0 : y1 - r0, x0 - c0 : x2 - c0]
+            connected_y[y0:y2, x0:x1] = cy[y0 - r0 : y2 - r0, x0 - c0 : x1 - c0]
+        del connectivity
+
+        if coarse is not None:
+            return {}
+
+        # Only the overlaps with the adjacent tiles are kept to estimate the offsets
+        # between tiles.
+        strips = {}
+        if r > 0:
+            strips["top"] = unwrapped[: row_bounds[r - 1][1] - r0].copy()
+        if r < nrows - 1:
+            strips["bottom"] = unwrapped[row_bounds[r + 1][0] - r0 :].copy()
+        if c > 0:
+            strips["left"] = unwrapped[:, : col_bounds[c - 1][1] - c0].copy()
+        if c < ncols - 1:
+            strips["right"] = unwrapped[:, col_bounds[c + 1][0] - c0 :].copy()
+        return strips
+
+    # Tiles are submitted in a sliding window of `max_workers` tiles rather than all at
+    # once, so that an error is raised without solving the remaining tiles, and the
+    # working set of at most `max_workers` tiles is held in memory at a time.
+    max_workers = num_threads if num_threads > 0 else (os.cpu_count() or 1)
+    tiles = itertools.product(range(nrows), range(ncols))
+    strips = {}
+    with ThreadPoolExecutor(max_workers=max_workers) as executor:
+        pending = {
+            executor.submit(solve_tile, r, c): (r, c)
+            for r, c in itertools.islice(tiles, max_workers)
+        }
+        while pending:
+            done, _ = wait(pending, return_when=FIRST_COMPLETED)
+            for future in done:
+                strips[pending.pop(future)] = future.result()
+                for r, c in itertools.islice(tiles, 1):
+                    pending[executor.submit(solve_tile, r, c)] = (r, c)
+
+    if coarse is None:
+        _apply_tile_offsets(strips, out, row_cores, col_cores)
+
+    if conncomp is None:
+        return out
+
+    # The two pixels of a pair that straddles the boundary between two tile cores are
+    # taken from different tiles, so the pair is also disconnected if the stitched
+    # phase has a cycle discontinuity across the boundary.
+    for y0, _ in row_cores[1:]:
+        connected_y[y0 - 1] &= np.abs(out[y0] - out[y0 - 1]) < np.pi
+    for x0, _ in col_cores[1:]:
+        connected_x[:, x0 - 1] &= np.abs(out[:, x0] - out[:, x0 - 1]) < np.pi
+
+    min_size = conncomp[1]
+    labels = label_connected_components(
+        connected_x, connected_y, min_size=min_size, num_threads=num_threads
+    )
+    return out, labels
+
+
 def unwrap(
     igram: ArrayLike,
     corr: ArrayLike,
     nlooks: float,
     *,
     mask: ArrayLike | None = None,
+    tile_shape: tuple[int, int] | None = None,
+    tile_overlap: int = 64,
+    coarse_looks: int | tuple[int, int] | None = None,
+    contract_zero_cost: bool = False,
+    return_conncomp: bool = False,
+    conncomp_cost_threshold: int = 0,
+    conncomp_min_size: int = 100,
+    num_threads: int = 0,
+    out: np.ndarray | None = None,
+) -> np.ndarray | tuple[np.ndarray, np.ndarray]:
+    """
+    Unwrap the phase of an interferogram.
+
+    Parameters
+    ----------
+    igram : array_like
+        The input interferogram. Must be a 2-D complex-valued array.
+    corr : array_like
+        The correlation coefficient of each pixel. Must be a 2-D array with the same
+        shape as `igram`.
+    nlooks : float
+        The effective number of looks used to form the interferogram.
+    mask : array_like or None, optional
+        An optional boolean mask with the same shape as `igram`. Defaults to None.
+    tile_shape : (int, int) or None, optional
+        If not None, the interferogram is split into overlapping tiles of (at most)
+        this shape, which are unwrapped independently and in parallel. The relative
+        cycle offset of each pair of adjacent tiles is estimated from their overlap, and
+        the offsets are then reconciled so that they are consistent across the whole
+        scene. Only the tiles being processed (and the overlaps between tiles) are held
+        in memory at once, in addition to the output, so inputs that are memory-mapped
+        are read one tile at a time. To unwrap scenes that are larger than memory, pass
+        a memory-mapped `out` array as well. If None, the full interferogram is
+        unwrapped as a single network. Defaults to None.
+    tile_overlap : int, optional
+        The minimum number of rows & columns that adjacent tiles overlap by. Must be
+        positive and less than each dimension of `tile_shape`. Unused if `tile_shape`
+        is None. Defaults to 64.
+    coarse_looks : int or (int, int) or None, optional
+        If not None, align the tiles to a coarse reference solution instead of
+        reconciling them from their overlaps. The interferogram & correlation are first
+        multilooked by this number of looks along each axis (a single integer is used
+        for both axes), and the multilooked interferogram is unwrapped as a single
+        network, which is 16x-64x smaller than the full-resolution network for typical
+        numbers of looks. The full-resolution interferogram is then unwrapped in tiles
+        (see `tile_shape`), and each tile is shifted by the single integer number of
+        cycles that best agrees with the coarse solution. This is not a coarse-to-fine
+        solve: the tiles are solved exactly as in plain tiled mode, without being
+        seeded or constrained by the coarse flows, so only the relative offsets of the
+        tiles can differ from plain tiled mode. If `tile_shape` is None, tiles of 32x32
+        multilooked pixels are used. Defaults to None.
+    contract_zero_cost : bool, optional
+        If True, each connected region of the network whose nodes are joined by
+        zero-cost arcs (e.g. masked areas) is contracted into a single node before
+        solving, and the solution is then expanded back to the full network. This can
+        be much faster for scenes with large masked or zero-cost areas. Unit capacities
+        are not enforced within the contracted regions. Defaults to False.
+    return_conncomp : bool, optional
+        If True, also label the connected components of the unwrapped phase. Two
+        adjacent pixels are connected if the costs of the arcs between them exceed
+        `conncomp_cost_threshold` in both directions, and if no flow crosses them in
+        the solution of the unwrapping network, i.e. it has no cycle discontinuity
+        between them. In tiled mode, the flows of the tile whose core contains a pair
+        are used, and pairs that straddle two tile cores must also differ by less than
+        pi radians in the stitched output. Defaults to False.
+    conncomp_cost_threshold : int, optional
+        The cost threshold for connecting adjacent pixels, in the same units as the
+        unwrapping costs. Unused if `return_conncomp` is False. Defaults to 0.
+    conncomp_min_size : int, optional
+        The minimum number of pixels in a labeled connected component. Unused if
+        `return_conncomp` is False. Defaults to 100.
+    num_threads : int, optional
+        The maximum number of tiles to unwrap concurrently, and the number of threads
+        used to label connected components. If zero, the number of CPUs in the system
+        is used. Defaults to 0.
+    out : numpy.ndarray or None, optional
+        An optional array to write the unwrapped phase to, e.g. a `numpy.memmap`. Must
+        be a writeable float32 or float64 array with the same shape as `igram`. In
+        tiled mode, the tiles are written to `out` as they are solved and the full
+        output is never held in memory, so a memory-mapped `out` is required for
+        scenes whose unwrapped phase does not fit in memory. If None, a new array is
+        allocated. Defaults to None.
+
+    Returns
+    -------
+    unwrapped : numpy.ndarray
+        The unwrapped phase, in radians. If `out` is not None, this is `out`.
+    conncomp : numpy.ndarray
+        The connected component label of each pixel, as an array of unsigned integers
+        with the same shape as `igram`. Components are labeled 1, 2, ... in order of
+        decreasing size. Pixels that are not part of any component with at least
+        `conncomp_min_size` pixels are labeled 0. Only returned if `return_conncomp`
+        is True.
+    """
+    if coarse_looks is not None:
+        if np.ndim(coarse_looks) == 0:
+            coarse_looks = (coarse_looks, coarse_looks)
+        coarse_looks = tuple(int(n) for n in coarse_looks)
+        if len(coarse_looks) != 2 or min(coarse_looks) < 1:
+            raise ValueError(
+                "coarse_looks must be a positive integer or a pair of positive integers"
+            )
+        if tile_shape is None:
+            tile_shape = (32 * coarse_looks[0], 32 * coarse_looks[1])
+
+    if num_threads < 0:
+        raise ValueError("num_threads must be non-negative")
+    if conncomp_min_size < 1:
+        raise ValueError("conncomp_min_size must be positive")
+    conncomp = None
+    if return_conncomp:
+        conncomp = (conncomp_cost_threshold, conncomp_min_size)
+
+    if out is not None:
+        if not isinstance(out, np.ndarray) or out.shape != np.shape(igram):
+            raise ValueError("out must be an array with the same shape as igram")
+        if out.dtype not in (np.float32, np.float64):
+            raise TypeError("out must have a float32 or float64 data type")
+        if not out.flags.writeable:
+            raise ValueError("out must be writeable")
+
+    if tile_shape is None:
+        unwrapped, connectivity = _unwrap_tile(
+            igram,
+            corr,
+            nlooks,
+            mask,
+            contract_zero_cost,
+            num_threads=num_threads,
+            conncomp_cost_threshold=None if conncomp is None else conncomp[0],
+        )
+        if out is not None:
+            out[...] = unwrapped
+            unwrapped = out
+        if conncomp is None:
+            return unwrapped
+
+        connected_x, connected_y = connectivity
+        labels = label_connected_components(
+            connected_x,
+            connected_y,
+            min_size=conncomp_min_size,
+            num_threads=num_threads,
+        )
+        return unwrapped, labels
+
+    if len(tile_shape) != 2 or min(tile_shape) < 2:
+        raise ValueError("tile_shape must be a pair of integers >= 2")
+    if not (0 < tile_overlap < min(tile_shape)):
+        raise ValueError(
+            "tile_overlap must be positive and less than each dimension of tile_shape"
+        )
+
+    return _unwrap_tiled(
+        igram,
+        corr,
+        nlooks,
+        mask,
+        tile_shape,
+        tile_overlap,
+        num_threads,
+        coarse_looks,
+        contract_zero_cost,
+        conncomp,
+        out,
+    )
+
+
+def unwrap_stack(
+    igrams: ArrayLike,
+    corrs: ArrayLike,
+    nlooks: float | ArrayLike,
+    *,
+    masks: ArrayLike | None = None,
+    num_threads: int = 0,
 ) -> np.ndarray:
-    """ """
-    phase = np.angle(igram)
+    """
+    Unwrap the phase of a stack of interferograms.
 
-    residue = get_residues(phase)
+    Each interferogram is unwrapped in the same way as by `unwrap()`. The residue
+    computation, network construction, solve and integration of each interferogram run
+    natively on a pool of worker threads, which share a single grid graph. The costs
+    of the next batch of interferograms are computed concurrently with the solves of
+    the current batch.
 
-    surplus = residue.flatten()
-    cost = compute_carballo_costs(igram, corr, nlooks, mask)
+    Parameters
+    ----------
+    igrams : array_like
+        The input interferograms. Must be a 3-D complex-valued array whose first axis
+        indexes the interferograms.
+    corrs : array_like
+        The correlation coefficient of each pixel of each interferogram. Must be a 3-D
+        array with the same shape as `igrams`.
+    nlooks : float or array_like
+        The effective number of looks used to form each interferogram. Either a scalar
+        (used for all interferograms) or a 1-D array with one entry per interferogram.
+    masks : array_like or None, optional
+        An optional boolean mask. Either a 2-D array, which is shared by all
+        interferograms, or a 3-D array with the same shape as `igrams`. Defaults to
+        None.
+    num_threads : int, optional
+        The number of worker threads to use. If zero, the number of CPUs in the system
+        is used. Defaults to 0.
+
+    Returns
+    -------
+    numpy.ndarray
+        The unwrapped phase of each interferogram, in radians, with the same shape as
+        `igrams`.
+    """
+    igrams = np.asanyarray(igrams)
+    corrs = np.asanyarray(corrs)
+    if igrams.ndim != 3:
+        raise ValueError("igrams must be a 3-D array")
+    if corrs.shape != igrams.shape:
+        raise ValueError("corrs must have the same shape as igrams")
+    if num_threads < 0:
+        raise ValueError("num_threads must be non-negative")
+
+    count = igrams.shape[0]
+    try:
+        nlooks = np.broadcast_to(np.asarray(nlooks, dtype=np.float64), (count,))
+    except ValueError:
+        raise ValueError(
+            "nlooks must be a scalar or have one entry per interferogram"
+        ) from None
+
+    if masks is not None:
+        masks = np.asanyarray(masks)
+        if masks.shape not in (igrams.shape, igrams.shape[1:]):
+            raise ValueError(
+                "masks must be a 2-D array or have the same shape as igrams"
+            )
+
+    def get_mask(i):  # type: ignore[no-untyped-def]
+        if masks is None or masks.ndim == 2:
+            return masks
+        return masks[i]
+
+    phase_dtype = np.angle(np.zeros(1, dtype=igrams.dtype)).dtype
+    out = np.empty(igrams.shape, dtype=phase_dtype)
+    if count == 0:
+        return out
+
+    residue_shape = get_residues(np.angle(igrams[0])).shape
+    graph = RectangularGridGraph(*residue_shape, index_dtype="auto")
+
+    max_workers = num_threads if num_threads > 0 else (os.cpu_count() or 1)
+    batch_size = 2 * max_workers
+
+    cost_pool = ThreadPoolExecutor(max_workers=max_workers)
+    prefetch_pool = ThreadPoolExecutor(max_workers=1)
+    with cost_pool, prefetch_pool:
+
+        def compute_cost(i):  # type: ignore[no-untyped-def]
+            return compute_carballo_costs(
+                igrams[i],
+                corrs[i],
+                nlooks[i],
+                get_mask(i),
+                # Interferograms are already processed concurrently.
+                num_threads=1,
+            )
 
-    graph = RectangularGridGraph(*residue.shape)
-    network = Network(graph, surplus, cost, capacity=1)
+        def prepare_batch(start):  # type: ignore[no-untyped-def]
+            stop = min(start + batch_size, count)
+            phase = np.ascontiguousarray(np.angle(igrams[start:stop]))
+            cost = np.stack(list(cost_pool.map(compute_cost, range(start, stop))))
+            return start, stop, phase, cost
 
-    primal_dual(network, maxiter=8)
+        pending = prefetch_pool.submit(prepare_batch, 0)
+        while pending is not None:
+            start, stop, phase, cost = pending.result()
+            pending = None
+            if stop < count:
+                pending = prefetch_pool.submit(prepare_batch, stop)
+            solve_stack(
+                phase, cost, graph._impl, out[start:stop], num_threads=num_threads
+            )
 
-    return integrate_unwrapped_gradients(phase, network._impl)
+    return out
@@ -1,7 +1,12 @@
+from __future__ import annotations
+
 from collections.abc import Iterable
 
+import numpy as np
+from numpy.typing import ArrayLike
+
 from . import _lib
-from ._edge_list import EdgeList
+from ._edge_list import EdgeList, _as_index_arrays
 
 __all__ = [
     "CSRGraph",
@@ -23,6 +28,124 @@ class CSRGraph:
         """Create a new `CSRGraph` from a sequence of (tail,head) pairs."""
         self._impl = _lib.CSRGraph(edge_list._impl)
 
+    @classmethod
+    def from_edge_arrays(
+        cls,
+        tails: ArrayLike,
+        heads: ArrayLike,
+        *,
+        num_vertices: int | None = None,
+    ) -> tuple[CSRGraph, np.ndarray]:
+        """
+        Create a new `CSRGraph` from arrays of tail & head vertices.
+
+        The edges are sorted by tail & head vertex in linear time before they're added
+        to the graph. The Python GIL is released during construction.
+
+        Parameters
+        ----------
+        tails : array_like
+            The tail vertex of each edge. Must be a 1-D array of non-negative integers.
+        heads : array_like
+            The head vertex of each edge. Must be a 1-D array of non-negative integers
+            with the same length as `tails`.
+        num_vertices : int or None, optional
+            The total number of vertices in the graph. Every vertex index must be less
+            than `num_vertices`, and the vertex with index ``num_vertices - 1`` must be
+            incident on at least one edge, since a `CSRGraph` cannot store trailing
+            isolated vertices. If None, one more than the largest vertex index is used.
+            Defaults to None.
+
+        Returns
+        -------
+        graph : CSRGraph
+            The new graph.
+        edge_ids : numpy.ndarray
+            The edge index in `graph` of each input edge. Edges in a CSR graph are
+            grouped by tail vertex, so this generally differs from the input order.
+        """
+        tails, heads = _as_index_arrays(tails=tails, heads=heads)
+        if len(tails) != len(heads):
+            raise ValueError("tails and heads must have the same length")
+
+        num_spanned = 0
+        if len(tails) > 0:
+            num_spanned = int(max(tails.max(), heads.max())) + 1
+        if num_vertices is None:
+            num_vertices = num_spanned
+        elif num_spanned > num_vertices:
+            raise ValueError("vertex indices must be less than num_vertices")
+        elif num_spanned < num_vertices:
+            raise ValueError(
+                "the last vertex must be incident on at least one edge; CSRGraph"
+                " cannot store trailing isolated vertices"
+            )
+
+        graph = cls.__new__(cls)
+        graph._impl, edge_ids = _lib.CSRGraph.from_edge_arrays(
+            tails=tails,
+            heads=heads,
+            num_vertices=num_vertices,
+        )
+        return graph, edge_ids
+
+    @classmethod
+    def from_csr_arrays(
+        cls, indptr: ArrayLike, indices: ArrayLike
+    ) -> tuple[CSRGraph, np.ndarray]:
+        """
+        Create a new `CSRGraph` from compressed sparse row index arrays.
+
+        The inputs follow the same convention as the `indptr` and `indices` attributes
+        of a `scipy.sparse.csr_array`: the heads of the outgoing edges of vertex `i` are
+        stored in ``indices[indptr[i]:indptr[i+1]]``. The Python GIL is released during
+        construction.
+
+        Parameters
+        ----------
+        indptr : array_like
+            The offset of each vertex's outgoing edges in `indices`. Must be a 1-D array
+            of non-decreasing integers whose first element is zero and whose last
+            element is the total number of edges. The number of vertices in the graph
+            is ``len(indptr) - 1``.
+        indices : array_like
+            The head vertex of each edge. Must be a 1-D array of non-negative integers
+            less than the number of vertices. The last vertex must be incident on at
+            least one edge, since a `CSRGraph` cannot store trailing isolated vertices.
+
+        Returns
+        -------
+        graph : CSRGraph
+            The new graph.
+        edge_ids : numpy.ndarray
+            The edge index in `graph` of each input edge.
+        """
+        indptr, indices = _as_index_arrays(indptr=indptr, indices=indices)
+        if len(indptr) == 0:
+            raise ValueError("indptr must not be empty")
+        if indptr[0] != 0 or indptr[-1] != len(indices):
+            raise ValueError(
+                "indptr must start at zero and end at the total number of edges"
+            )
+        if np.any(indptr[1:] < indptr[:-1]):
+            raise ValueError("indptr must be non-decreasing")
+
+        num_vertices = len(indptr) - 1
+        if len(indices) > 0 and indices.max() >= num_vertices:
+            raise ValueError("indices must be less than the number of vertices")
+        last_is_isolated = indptr[-2] == indptr[-1] if num_vertices > 0 else False
+        if last_is_isolated and not np.any(indices == num_vertices - 1):
+            raise ValueError(
+                "the last vertex must be incident on at least one edge; CSRGraph"
+                " cannot store trailing isolated vertices"
+            )
+
+        graph = cls.__new__(cls)
+        graph._impl, edge_ids = _lib.CSRGraph.from_csr_arrays(
+            indptr=indptr, indices=indices
+        )
+        return graph, edge_ids
+
     @property
     def num_vertices(self) -> int:
         """int : The total number of vertices in the graph."""  # noqa: D403
@@ -129,3 +252,48 @@ class CSRGraph:
             A view of the vertex's outgoing incident edges and successor vertices.
         """
         return self._impl.outgoing_edges(vertex)
+
+    def outdegree_array(self) -> np.ndarray:
+        """
+        Get the outdegree of every vertex in the graph.
+
+        Returns
+        -------
+        numpy.ndarray
+            A 1-D array containing the number of outgoing edges of each vertex, indexed
+            by vertex index.
+        """
+        return self._impl.outdegree_array()
+
+    def edge_array(self) -> np.ndarray:
+        """
+        Get the tail and head vertex indices of every edge in the graph.
+
+        Returns
+        -------
+        numpy.ndarray
+            An E x 2 array, where E is the total number of edges, whose i-th row
+            contains the indices of the tail and head vertices of the edge with index
+            i.
+        """
+        return self._impl.edge_array()
+
+    def csr_arrays(self) -> tuple[np.ndarray, np.ndarray, np.ndarray]:
+        """
+        Get the adjacency structure of the graph in compressed sparse row format.
+
+        The outgoing edges of the vertex with index `i` are stored in the range
+        ``indptr[i]:indptr[i+1]`` of `indices` and `edge_ids`. The first two outputs
+        are compatible with `scipy.sparse.csr_array`.
+
+        Returns
+        -------
+        indptr : numpy.ndarray
+            The offset of each vertex's outgoing edges. Its length is V + 1, where V
+            is the total number of vertices.
+        indices : numpy.ndarray
+            The head vertex index of each outgoing edge.
+        edge_ids : numpy.ndarray
+            The edge index of each outgoing edge.
+        """
+        return self._impl.csr_arrays()
@@ -1,5 +1,10 @@
+from __future__ import annotations
+
 from collections.abc import Iterator
 
+import numpy as np
+from numpy.typing import ArrayLike
+
 from . import _lib
 
 __all__ = [
@@ -7,6 +12,40 @@ __all__ = [
 ]
 
 
+# The integer types of vertex index arrays that are accepted natively without a copy.
+_INDEX_DTYPES = (np.int32, np.int64, np.uint32, np.uint64)
+
+
+def _as_index_arrays(**arrays: ArrayLike) -> tuple[np.ndarray, ...]:
+    """
+    Validate arrays of vertex indices and convert them to a common native index type.
+
+    Each array must be a 1-D array of non-negative integers. Contiguous arrays of
+    32- or 64-bit integers that share the same type are returned without a copy.
+    Otherwise, the arrays are converted to 64-bit integers.
+    """
+    out = []
+    for name, values in arrays.items():
+        arr = np.asarray(values)
+        if arr.ndim != 1:
+            msg = f"{name} must be a 1-D array"
+            raise ValueError(msg)
+        if arr.size == 0:
+            arr = arr.astype(np.int64)
+        if not np.issubdtype(arr.dtype, np.integer):
+            msg = f"{name} must be an array of integers"
+            raise TypeError(msg)
+        if np.issubdtype(arr.dtype, np.signedinteger) and arr.size and arr.min() < 0:
+            msg = f"{name} must not contain negative indices"
+            raise ValueError(msg)
+        out.append(arr)
+
+    dtypes = {arr.dtype for arr in out}
+    if len(dtypes) != 1 or dtypes.pop() not in _INDEX_DTYPES:
+        out = [arr.astype(np.int64) for arr in out]
+    return tuple(np.ascontiguousarray(arr) for arr in out)
+
+
 class EdgeList:
     """A sequence of (tail,head) vertex pairs."""
 
@@ -15,6 +54,35 @@ class EdgeList:
     def __init__(self):  # type: ignore[no-untyped-def]
         self._impl = _lib.EdgeList()
 
+    @classmethod
+    def from_arrays(cls, tails: ArrayLike, heads: ArrayLike) -> EdgeList:
+        """
+        Create a new `EdgeList` from arrays of tail & head vertices.
+
+        The edges are added natively in a single pass, in the order in which they
+        appear in the input arrays.
+
+        Parameters
+        ----------
+        tails : array_like
+            The tail vertex of each edge. Must be a 1-D array of non-negative integers.
+        heads : array_like
+            The head vertex of each edge. Must be a 1-D array of non-negative integers
+            with the same length as `tails`.
+
+        Returns
+        -------
+        EdgeList
+            The new edge list.
+        """
+        tails, heads = _as_index_arrays(tails=tails, heads=heads)
+        if len(tails) != len(heads):
+            raise ValueError("tails and heads must have the same length")
+
+        edge_list = cls.__new__(cls)
+        edge_list._impl = _lib.EdgeList(tails=tails, heads=heads)
+        return edge_list
+
     @property
     def size(self) -> int:
         """The total number of edges."""
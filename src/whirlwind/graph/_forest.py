@@ -1,7 +1,11 @@
 from collections.abc import Iterable
 from typing import TypeVar
 
+import numpy as np
+from numpy.typing import ArrayLike
+
 from . import _lib
+from ._edge_list import _as_index_arrays
 
 __all__ = [
     "Forest",
@@ -200,3 +204,88 @@ class Forest:
         predecessor edge is set to the value of `edge_fill_value`.
         """
         self._impl.reset()
+
+    def root_vertex_array(self, *, num_threads: int = 0) -> np.ndarray:
+        """
+        Get the root vertex of the tree containing each vertex.
+
+        The trees are traversed in parallel by pointer jumping, so the total work is
+        proportional to V log(D), where V is the total number of vertices and D is the
+        maximum depth of any tree in the forest. The Python GIL is released during
+        traversal. Raises `ValueError` if the predecessors contain a cycle.
+
+        Parameters
+        ----------
+        num_threads : int, optional
+            The number of worker threads to use. If zero, the number of concurrent
+            threads supported by the hardware is used. Defaults to 0.
+
+        Returns
+        -------
+        numpy.ndarray
+            A 1-D array containing the vertex index of the root of each vertex's tree,
+            indexed by vertex index.
+        """
+        return self._impl.root_vertex_array(num_threads=num_threads)
+
+    def depth_array(self, *, num_threads: int = 0) -> np.ndarray:
+        """
+        Get the depth of every vertex in the forest.
+
+        Equivalent to calling `depth()` on each vertex, but the trees are traversed in
+        parallel by pointer jumping. The Python GIL is released during traversal.
+        Raises `ValueError` if the predecessors contain a cycle.
+
+        Parameters
+        ----------
+        num_threads : int, optional
+            The number of worker threads to use. If zero, the number of concurrent
+            threads supported by the hardware is used. Defaults to 0.
+
+        Returns
+        -------
+        numpy.ndarray
+            A 1-D array containing the depth of each vertex, indexed by vertex index.
+        """
+        return self._impl.depth_array(num_threads=num_threads)
+
+    def paths_to_root(
+        self, vertex_ids: ArrayLike, *, num_threads: int = 0
+    ) -> tuple[np.ndarray, np.ndarray, np.ndarray]:
+        """
+        Get the predecessors of many vertices on the paths to their roots.
+
+        Equivalent to calling `predecessors()` on each input vertex, with the results
+        concatenated into flat arrays of vertex and edge indices. The predecessors of
+        the i-th input vertex are stored in the range ``offsets[i]:offsets[i+1]`` of
+        `pred_vertex_ids` and `pred_edge_ids`, ordered from the input vertex toward the
+        root. Paths are traversed in parallel with the Python GIL released. Raises
+        `ValueError` if the path from any input vertex contains a cycle.
+
+        Parameters
+        ----------
+        vertex_ids : array_like
+            The vertex indices of the input vertices. Must be a 1-D array of integers in
+            the range [0, V), where V is the total number of vertices.
+        num_threads : int, optional
+            The number of worker threads to use. If zero, the number of concurrent
+            threads supported by the hardware is used. Defaults to 0.
+
+        Returns
+        -------
+        offsets : numpy.ndarray
+            The offset of each path. Its length is one more than the number of input
+            vertices.
+        pred_vertex_ids : numpy.ndarray
+            The vertex index of each predecessor vertex.
+        pred_edge_ids : numpy.ndarray
+            The edge index of each predecessor edge.
+        """
+        (vertex_ids,) = _as_index_arrays(vertex_ids=vertex_ids)
+        if len(vertex_ids) > 0 and vertex_ids.max() >= self._impl.graph.num_vertices:
+            raise ValueError("vertex_ids must be less than the number of vertices")
+
+        return self._impl.paths_to_root(
+            vertex_ids=vertex_ids.astype(np.uint64, copy=False),
+            num_threads=num_threads,
+        )
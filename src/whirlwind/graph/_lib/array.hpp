@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <nanobind/ndarray.h>
+
+namespace whirlwind::bindings {
+
+namespace nb = nanobind;
+
+template<class T, std::size_t Rank>
+using PyContiguousArrayND =
+        nb::ndarray<T, nb::ndim<Rank>, nb::c_contig, nb::device::cpu>;
+
+template<class T>
+using PyContiguousArray1D = PyContiguousArrayND<T, 1>;
+
+template<class T>
+using NumPyArray = nb::ndarray<T, nb::numpy>;
+
+template<class T, std::size_t Rank>
+using NumPyArrayND = nb::ndarray<T, nb::numpy, nb::ndim<Rank>>;
+
+template<class T>
+using NumPyArray1D = NumPyArrayND<T, 1>;
+
+template<class T, class Allocator>
+[[nodiscard]] auto
+to_numpy_array(std::vector<T, Allocator> arr) -> NumPyArray1D<T>
+{
+    auto out = new auto(std::move(arr));
+    auto owner = nb::capsule(
+            out, [](void* p) noexcept { delete static_cast<decltype(out)>(p); });
+    return NumPyArray1D<T>(out->data(), {out->size()}, std::move(owner));
+}
+
+template<class T, class Allocator>
+[[nodiscard]] auto
+to_numpy_array(std::vector<T, Allocator> arr, const std::vector<std::size_t>& shape)
+        -> NumPyArray<T>
+{
+    auto out = new auto(std::move(arr));
+    auto owner = nb::capsule(
+            out, [](void* p) noexcept { delete static_cast<decltype(out)>(p); });
+    return NumPyArray<T>(out->data(), shape.size(), shape.data(), std::move(owner));
+}
+
+} // namespace whirlwind::bindings
@@ -1,8 +1,20 @@
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 #include <nanobind/nanobind.h>
+#include <nanobind/stl/tuple.h>
 
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
 #include <whirlwind/graph/csr_graph.hpp>
 #include <whirlwind/graph/edge_list.hpp>
 
+#include "array.hpp"
+#include "csr_graph.hpp"
 #include "graph.hpp"
 
 namespace whirlwind::bindings {
@@ -10,6 +22,71 @@ namespace whirlwind::bindings {
 namespace nb = nanobind;
 using namespace nb::literals;
 
+// Bind the bulk constructors for input index arrays of type `Index`, so that NumPy and
+// SciPy index arrays of the common integer types are used without a copy. The indices
+// are assumed to have been validated by the caller.
+template<class Index, class Class>
+void
+csr_graph_bulk_constructors(nb::class_<Class>& cls)
+{
+    cls.def_static(
+            "from_edge_arrays",
+            [](const PyContiguousArray1D<const Index>& tails,
+               const PyContiguousArray1D<const Index>& heads, Size num_vertices) {
+                WHIRLWIND_ASSERT(tails.size() == heads.size());
+
+                const auto tails_span = std::span(tails.data(), tails.size());
+                const auto heads_span = std::span(heads.data(), heads.size());
+
+                auto [graph, edge_ids] = [&]() {
+                    [[maybe_unused]] const nb::gil_scoped_release nogil;
+                    return make_csr_graph(tails_span, heads_span, num_vertices);
+                }();
+
+                auto edge_ids_array = to_numpy_array(std::move(edge_ids));
+                return std::tuple{std::move(graph), std::move(edge_ids_array)};
+            },
+            "tails"_a.noconvert(), "heads"_a.noconvert(), "num_vertices"_a);
+    cls.def_static(
+            "from_csr_arrays",
+            [](const PyContiguousArray1D<const Index>& indptr,
+               const PyContiguousArray1D<const Index>& indices) {
+                WHIRLWIND_ASSERT(indptr.size() >= 1);
+
+                const auto indptr_span = std::span(indptr.data(), indptr.size());
+                const auto heads_span = std::span(indices.data(), indices.size());
+                const auto num_vertices = static_cast<Size>(indptr_span.size() - 1);
+                const auto num_edges = static_cast<Size>(heads_span.size());
+
+                // Guard the expansion below against out-of-bounds writes.
+                WHIRLWIND_ASSERT(indptr_span[0] == Index{0});
+                WHIRLWIND_ASSERT(static_cast<Size>(indptr_span[num_vertices]) ==
+                                 num_edges);
+                for (Size v = 0; v < num_vertices; ++v) {
+                    WHIRLWIND_ASSERT(indptr_span[v] <= indptr_span[v + 1]);
+                }
+
+                auto [graph, edge_ids] = [&]() {
+                    [[maybe_unused]] const nb::gil_scoped_release nogil;
+
+                    // Expand the row offsets into the tail vertex of each edge.
+                    auto tails = std::vector<Index>(num_edges);
+                    for (Size v = 0; v < num_vertices; ++v) {
+                        const auto first = static_cast<Size>(indptr_span[v]);
+                        const auto last = static_cast<Size>(indptr_span[v + 1]);
+                        std::fill(tails.begin() + first, tails.begin() + last,
+                                  static_cast<Index>(v));
+                    }
+
+                    return make_csr_graph<Index>(tails, heads_span, num_vertices);
+                }();
+
+                auto edge_ids_array = to_numpy_array(std::move(edge_ids));
+                return std::tuple{std::move(graph), std::move(edge_ids_array)};
+            },
+            "indptr"_a.noconvert(), "indices"_a.noconvert());
+}
+
 template<class Class>
 void
 csr_graph_attrs_and_methods(nb::class_<Class>& cls)
@@ -21,6 +98,12 @@ csr_graph_attrs_and_methods(nb::class_<Class>& cls)
     cls.def(nb::init<EdgeList<Vertex>>(), "edge_list"_a,
             nb::call_guard<nb::gil_scoped_release>());
 
+    // Static methods.
+    csr_graph_bulk_constructors<std::int32_t>(cls);
+    csr_graph_bulk_constructors<std::int64_t>(cls);
+    csr_graph_bulk_constructors<std::uint32_t>(cls);
+    csr_graph_bulk_constructors<std::uint64_t>(cls);
+
     common_graph_attrs_and_methods(cls);
 }
 
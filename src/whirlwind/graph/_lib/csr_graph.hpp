@@ -0,0 +1,79 @@
+#pragma once
+
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/edge_list.hpp>
+
+namespace whirlwind::bindings {
+
+// Stably sort the edge indices in `in` by `keys[i]` using a counting sort, writing the
+// result to `out`. The keys must be less than `num_keys`.
+template<class Index>
+void
+counting_sort(std::span<const Index> keys,
+              std::span<const Size> in,
+              Size num_keys,
+              std::span<Size> out)
+{
+    auto offsets = std::vector<Size>(num_keys + 1, 0);
+    for (const auto& i : in) {
+        ++offsets[static_cast<Size>(keys[i]) + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for (const auto& i : in) {
+        out[offsets[static_cast<Size>(keys[i])]++] = i;
+    }
+}
+
+// Build a `CSRGraph` with `num_vertices` vertices from parallel arrays of tail & head
+// vertex indices of any integer type. The indices must be non-negative and less than
+// `num_vertices`, and the last vertex must be incident on at least one edge, since
+// `CSRGraph` takes its vertex count from the largest vertex index among its edges.
+//
+// The edges are sorted by (tail,head) with two counting sorts before they're inserted,
+// so that the `CSRGraph` constructor finds them already in CSR order and the edge with
+// index k in the new graph is the k-th inserted edge.
+//
+// Returns the graph along with the edge index in the new graph of each input edge.
+// Parallel edges are matched in order of appearance.
+template<class Index>
+[[nodiscard]] auto
+make_csr_graph(std::span<const Index> tails,
+               std::span<const Index> heads,
+               Size num_vertices) -> std::pair<CSRGraph<>, std::vector<Size>>
+{
+    using Vertex = typename CSRGraph<>::vertex_type;
+
+    WHIRLWIND_ASSERT(tails.size() == heads.size());
+    const auto num_edges = static_cast<Size>(tails.size());
+
+    auto order = std::vector<Size>(num_edges);
+    std::iota(order.begin(), order.end(), Size{0});
+    auto by_head = std::vector<Size>(num_edges);
+    counting_sort<Index>(heads, order, num_vertices, by_head);
+    counting_sort<Index>(tails, by_head, num_vertices, order);
+
+    auto edge_list = EdgeList<Vertex>();
+    for (const auto& i : order) {
+        edge_list.add_edge(static_cast<Vertex>(tails[i]),
+                           static_cast<Vertex>(heads[i]));
+    }
+    auto graph = CSRGraph<>(std::move(edge_list));
+    WHIRLWIND_ASSERT(static_cast<Size>(graph.num_vertices()) == num_vertices);
+
+    // Reuse the intermediate buffer for the output.
+    auto& edge_ids = by_head;
+    for (Size k = 0; k < num_edges; ++k) {
+        edge_ids[order[k]] = k;
+    }
+
+    return {std::move(graph), std::move(edge_ids)};
+}
+
+} // namespace whirlwind::bindings
@@ -1,8 +1,13 @@
+#include <cstddef>
+#include <cstdint>
+
 #include <nanobind/nanobind.h>
 
+#include <whirlwind/common/assert.hpp>
 #include <whirlwind/common/stddef.hpp>
 #include <whirlwind/graph/edge_list.hpp>
 
+#include "array.hpp"
 #include "sequence.hpp"
 
 namespace whirlwind::bindings {
@@ -10,6 +15,35 @@ namespace whirlwind::bindings {
 namespace nb = nanobind;
 using namespace nb::literals;
 
+// Bind a constructor from arrays of tail & head vertex indices of type `Index`, so that
+// NumPy index arrays of the common integer types are used without a copy. The indices
+// are assumed to have been validated by the caller.
+template<class Index, class Vertex, template<class> class Container>
+void
+edge_list_array_constructor(nb::class_<EdgeList<Vertex, Container>>& cls)
+{
+    using Class = EdgeList<Vertex, Container>;
+
+    cls.def(
+            "__init__",
+            [](Class* self, const PyContiguousArray1D<const Index>& tails,
+               const PyContiguousArray1D<const Index>& heads) {
+                WHIRLWIND_ASSERT(tails.size() == heads.size());
+
+                const auto num_edges = tails.size();
+                const auto* tails_data = tails.data();
+                const auto* heads_data = heads.data();
+
+                auto* edge_list = new (self) Class();
+                for (std::size_t i = 0; i < num_edges; ++i) {
+                    edge_list->add_edge(static_cast<Vertex>(tails_data[i]),
+                                        static_cast<Vertex>(heads_data[i]));
+                }
+            },
+            "tails"_a.noconvert(), "heads"_a.noconvert(),
+            nb::call_guard<nb::gil_scoped_release>());
+}
+
 template<class Vertex, template<class> class Container>
 void
 edge_list_attrs_and_methods(nb::class_<EdgeList<Vertex, Container>>& cls)
@@ -18,6 +52,10 @@ edge_list_attrs_and_methods(nb::class_<EdgeList<Vertex, Container>>& cls)
 
     // Constructors.
     cls.def(nb::init<>());
+    edge_list_array_constructor<std::int32_t>(cls);
+    edge_list_array_constructor<std::int64_t>(cls);
+    edge_list_array_constructor<std::uint32_t>(cls);
+    edge_list_array_constructor<std::uint64_t>(cls);
 
     // Attributes & properties.
     cls.def_prop_ro("size", &Class::size);
@@ -1,12 +1,19 @@
+#include <span>
+#include <tuple>
 #include <utility>
 
 #include <nanobind/nanobind.h>
+#include <nanobind/stl/tuple.h>
+
+#include <whirlwind/common/stddef.hpp>
 
 #include <whirlwind/common/type_traits.hpp>
 #include <whirlwind/graph/csr_graph.hpp>
 #include <whirlwind/graph/forest.hpp>
 #include <whirlwind/graph/rectangular_grid_graph.hpp>
 
+#include "array.hpp"
+#include "forest.hpp"
 #include "iterable.hpp"
 
 namespace whirlwind::bindings {
@@ -44,6 +51,43 @@ forest_attrs_and_methods(nb::class_<Forest<Graph, Container>>& cls)
     cls.def("make_root_vertex", &Class::make_root_vertex, "vertex"_a);
     cls.def("is_root_vertex", &Class::is_root_vertex, "vertex"_a);
     cls.def("reset", &Class::reset);
+    cls.def(
+            "root_vertex_array",
+            [](const Class& self, Size num_threads) {
+                auto roots = [&]() {
+                    [[maybe_unused]] const nb::gil_scoped_release nogil;
+                    return get_roots_and_depths(self, num_threads).first;
+                }();
+                return to_numpy_array(std::move(roots));
+            },
+            "num_threads"_a = 0);
+    cls.def(
+            "depth_array",
+            [](const Class& self, Size num_threads) {
+                auto depths = [&]() {
+                    [[maybe_unused]] const nb::gil_scoped_release nogil;
+                    return get_roots_and_depths(self, num_threads).second;
+                }();
+                return to_numpy_array(std::move(depths));
+            },
+            "num_threads"_a = 0);
+    cls.def(
+            "paths_to_root",
+            [](const Class& self, const PyContiguousArray1D<const Size>& vertex_ids,
+               Size num_threads) {
+                const auto vertex_ids_span =
+                        std::span(vertex_ids.data(), vertex_ids.size());
+
+                auto [offsets, pred_vertices, pred_edges] = [&]() {
+                    [[maybe_unused]] const nb::gil_scoped_release nogil;
+                    return get_paths_to_root(self, vertex_ids_span, num_threads);
+                }();
+
+                return std::tuple{to_numpy_array(std::move(offsets)),
+                                  to_numpy_array(std::move(pred_vertices)),
+                                  to_numpy_array(std::move(pred_edges))};
+            },
+            "vertex_ids"_a, "num_threads"_a = 0);
 }
 
 template<class Graph>
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <atomic>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
+
+#include "graph.hpp"
+#include "parallel.hpp"
+
+namespace whirlwind::bindings {
+
+// Get the predecessor vertex index of each vertex in the forest, indexed by vertex
+// index. The predecessor of a root vertex is itself.
+template<class Forest>
+[[nodiscard]] auto
+get_predecessor_vertex_ids(const Forest& forest, Size num_threads = 0)
+        -> std::vector<Size>
+{
+    const auto& graph = forest.graph();
+    const auto vertices = get_vertex_list(graph);
+    auto preds = std::vector<Size>(vertices.size());
+    parallel_for(vertices.size(), num_threads, [&](Size begin, Size end) {
+        for (Size i = begin; i < end; ++i) {
+            preds[i] = graph.get_vertex_id(forest.predecessor_vertex(vertices[i]));
+        }
+    });
+    return preds;
+}
+
+// Label each vertex in the forest with the index of the root vertex of its tree and its
+// depth, indexed by vertex index. Throws `std::invalid_argument` if the predecessors
+// contain a cycle.
+//
+// Uses parallel pointer jumping: on each pass, every vertex replaces its ancestor with
+// that ancestor's ancestor while accumulating the distance between them, so the total
+// number of passes is logarithmic in the depth of the deepest tree.
+template<class Forest>
+[[nodiscard]] auto
+get_roots_and_depths(const Forest& forest, Size num_threads = 0)
+        -> std::pair<std::vector<Size>, std::vector<Size>>
+{
+    auto ancestors = get_predecessor_vertex_ids(forest, num_threads);
+    const auto num_vertices = static_cast<Size>(ancestors.size());
+
+    auto depths = std::vector<Size>(num_vertices);
+    for (Size i = 0; i < num_vertices; ++i) {
+        depths[i] = (ancestors[i] == i) ? 0 : 1;
+    }
+
+    // Each pass reads from one pair of buffers and writes to the other.
+    auto next_ancestors = std::vector<Size>(num_vertices);
+    auto next_depths = std::vector<Size>(num_vertices);
+
+    auto changed = std::atomic<bool>(true);
+    for (Size distance = 1; changed.load(std::memory_order_relaxed); distance *= 2) {
+        // The distance spanned by each jump can't exceed the number of vertices unless
+        // the predecessors contain a cycle, in which case the loop would never end.
+        if (distance > 2 * num_vertices) {
+            throw std::invalid_argument("forest predecessors contain a cycle");
+        }
+
+        changed.store(false, std::memory_order_relaxed);
+        parallel_for(num_vertices, num_threads, [&](Size begin, Size end) {
+            auto local_changed = false;
+            for (Size i = begin; i < end; ++i) {
+                const auto ancestor = ancestors[i];
+                next_ancestors[i] = ancestors[ancestor];
+                next_depths[i] = depths[i] + depths[ancestor];
+                local_changed |= (next_ancestors[i] != ancestor);
+            }
+            if (local_changed) {
+                changed.store(true, std::memory_order_relaxed);
+            }
+        });
+
+        std::swap(ancestors, next_ancestors);
+        std::swap(depths, next_depths);
+    }
+
+    return {std::move(ancestors), std::move(depths)};
+}
+
+// Get the predecessors of each of the specified vertices on the path to the root of its
+// tree, in the same order as `Forest::predecessors()`. The vertex indices must be less
+// than the number of vertices in the graph. Throws `std::invalid_argument` if any path
+// contains a cycle.
+//
+// The result is a ragged array: the predecessor vertex indices and edge indices of the
+// i-th input vertex are stored in the range [offsets[i], offsets[i+1]) of the second
+// and third outputs, respectively.
+template<class Forest>
+[[nodiscard]] auto
+get_paths_to_root(const Forest& forest,
+                  std::span<const Size> vertex_ids,
+                  Size num_threads = 0)
+        -> std::tuple<std::vector<Size>, std::vector<Size>, std::vector<Size>>
+{
+    const auto& graph = forest.graph();
+    const auto vertices = get_vertex_list(graph);
+    const auto num_paths = static_cast<Size>(vertex_ids.size());
+
+    // Get the length of each path.
+    auto offsets = std::vector<Size>(num_paths + 1, 0);
+    parallel_for(num_paths, num_threads, [&](Size begin, Size end) {
+        for (Size i = begin; i < end; ++i) {
+            WHIRLWIND_ASSERT(vertex_ids[i] < vertices.size());
+            Size length = 0;
+            auto vertex = vertices[vertex_ids[i]];
+            while (!forest.is_root_vertex(vertex)) {
+                // A path longer than the number of vertices must contain a cycle.
+                if (length == vertices.size()) {
+                    throw std::invalid_argument("forest predecessors contain a cycle");
+                }
+                vertex = forest.predecessor_vertex(vertex);
+                ++length;
+            }
+            offsets[i + 1] = length;
+        }
+    });
+
+    for (Size i = 0; i < num_paths; ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+
+    auto pred_vertices = std::vector<Size>(offsets.back());
+    auto pred_edges = std::vector<Size>(offsets.back());
+    parallel_for(num_paths, num_threads, [&](Size begin, Size end) {
+        for (Size i = begin; i < end; ++i) {
+            const auto& vertex = vertices[vertex_ids[i]];
+            auto j = offsets[i];
+            for (const auto& [tail, edge] : forest.predecessors(vertex)) {
+                pred_vertices[j] = graph.get_vertex_id(tail);
+                pred_edges[j] = graph.get_edge_id(edge);
+                ++j;
+            }
+            WHIRLWIND_ASSERT(j == offsets[i + 1]);
+        }
+    });
+
+    return {std::move(offsets), std::move(pred_vertices), std::move(pred_edges)};
+}
+
+} // namespace whirlwind::bindings
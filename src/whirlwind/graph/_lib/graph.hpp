@@ -1,18 +1,105 @@
 #pragma once
 
+#include <cstddef>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include <nanobind/nanobind.h>
+#include <nanobind/stl/tuple.h>
 
+#include <whirlwind/common/stddef.hpp>
 #include <whirlwind/common/type_traits.hpp>
 
+#include "array.hpp"
 #include "iterable.hpp"
+#include "parallel.hpp"
 
 namespace whirlwind::bindings {
 
 namespace nb = nanobind;
 using namespace nb::literals;
 
+// Collect the vertices of a graph, indexed by vertex index.
+template<class Graph>
+[[nodiscard]] auto
+get_vertex_list(const Graph& graph) -> std::vector<typename Graph::vertex_type>
+{
+    auto vertices = std::vector<typename Graph::vertex_type>();
+    vertices.reserve(graph.num_vertices());
+    for (const auto& vertex : graph.vertices()) {
+        vertices.push_back(vertex);
+    }
+    return vertices;
+}
+
+// Get the outdegree of each vertex in the graph, indexed by vertex index.
+template<class Graph>
+[[nodiscard]] auto
+get_outdegrees(const Graph& graph) -> std::vector<Size>
+{
+    const auto vertices = get_vertex_list(graph);
+    auto outdegrees = std::vector<Size>(vertices.size());
+    parallel_for(vertices.size(), 0, [&](Size begin, Size end) {
+        for (Size i = begin; i < end; ++i) {
+            outdegrees[i] = graph.outdegree(vertices[i]);
+        }
+    });
+    return outdegrees;
+}
+
+// Get the (tail,head) vertex indices of each edge in the graph as a row-major E x 2
+// array, indexed by edge index.
+template<class Graph>
+[[nodiscard]] auto
+get_edge_array(const Graph& graph) -> std::vector<Size>
+{
+    const auto vertices = get_vertex_list(graph);
+    auto edges = std::vector<Size>(2 * static_cast<Size>(graph.num_edges()));
+    parallel_for(vertices.size(), 0, [&](Size begin, Size end) {
+        for (Size tail = begin; tail < end; ++tail) {
+            for (const auto& [edge, head] : graph.outgoing_edges(vertices[tail])) {
+                const auto edge_id = static_cast<Size>(graph.get_edge_id(edge));
+                edges[2 * edge_id] = tail;
+                edges[2 * edge_id + 1] = graph.get_vertex_id(head);
+            }
+        }
+    });
+    return edges;
+}
+
+// Get the adjacency structure of the graph in compressed sparse row format. Returns the
+// offset of each vertex's outgoing edges, followed by the head vertex index and edge
+// index of each outgoing edge, grouped by tail vertex.
+template<class Graph>
+[[nodiscard]] auto
+get_csr_arrays(const Graph& graph)
+        -> std::tuple<std::vector<Size>, std::vector<Size>, std::vector<Size>>
+{
+    const auto vertices = get_vertex_list(graph);
+    const auto num_vertices = static_cast<Size>(vertices.size());
+
+    auto offsets = std::vector<Size>(num_vertices + 1, 0);
+    for (Size i = 0; i < num_vertices; ++i) {
+        offsets[i + 1] = offsets[i] + graph.outdegree(vertices[i]);
+    }
+
+    auto heads = std::vector<Size>(offsets.back());
+    auto edges = std::vector<Size>(offsets.back());
+    parallel_for(num_vertices, 0, [&](Size begin, Size end) {
+        for (Size tail = begin; tail < end; ++tail) {
+            auto j = offsets[tail];
+            for (const auto& [edge, head] : graph.outgoing_edges(vertices[tail])) {
+                heads[j] = graph.get_vertex_id(head);
+                edges[j] = graph.get_edge_id(edge);
+                ++j;
+            }
+        }
+    });
+
+    return {std::move(offsets), std::move(heads), std::move(edges)};
+}
+
 template<class Graph>
 void
 common_graph_attrs_and_methods(nb::class_<Graph>& cls)
@@ -31,6 +118,30 @@ common_graph_attrs_and_methods(nb::class_<Graph>& cls)
     cls.def("outdegree", &Graph::outdegree, "vertex"_a);
     cls.def("outgoing_edges", &Graph::outgoing_edges, "vertex"_a,
             nb::keep_alive<0, 1>());
+    cls.def("outdegree_array", [](const Graph& self) {
+        auto outdegrees = [&]() {
+            [[maybe_unused]] const nb::gil_scoped_release nogil;
+            return get_outdegrees(self);
+        }();
+        return to_numpy_array(std::move(outdegrees));
+    });
+    cls.def("edge_array", [](const Graph& self) {
+        auto edges = [&]() {
+            [[maybe_unused]] const nb::gil_scoped_release nogil;
+            return get_edge_array(self);
+        }();
+        const auto num_edges = static_cast<std::size_t>(self.num_edges());
+        return to_numpy_array(std::move(edges), {num_edges, 2});
+    });
+    cls.def("csr_arrays", [](const Graph& self) {
+        auto [offsets, heads, edges] = [&]() {
+            [[maybe_unused]] const nb::gil_scoped_release nogil;
+            return get_csr_arrays(self);
+        }();
+        return std::tuple{to_numpy_array(std::move(offsets)),
+                          to_numpy_array(std::move(heads)),
+                          to_numpy_array(std::move(edges))};
+    });
 
     using Vertex = typename Graph::vertex_type;
     using Vertices = remove_cvref_t<decltype(std::declval<Graph>().vertices())>;
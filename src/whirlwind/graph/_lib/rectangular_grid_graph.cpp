@@ -1,3 +1,5 @@
+#include <cstdint>
+
 #include <nanobind/nanobind.h>
 
 #include <whirlwind/common/stddef.hpp>
@@ -46,11 +48,32 @@ rectangular_grid_graph(nb::module_& m, const char* name)
     rectangular_grid_graph_attrs_and_methods(graph);
 }
 
+template<Size P, class Dim>
+void
+rectangular_grid_graph(nb::module_& m, const char* name)
+{
+    using Class = RectangularGridGraph<P, Dim>;
+
+    // An explicit index type may coincide with the default one, in which case the
+    // existing class is exposed under the additional name.
+    if (nb::type<Class>().is_valid()) {
+        m.attr(name) = nb::type<Class>();
+        return;
+    }
+
+    auto graph = nb::class_<Class>(m, name);
+    rectangular_grid_graph_attrs_and_methods(graph);
+}
+
 void
 rectangular_grid_graph(nb::module_& m)
 {
     rectangular_grid_graph<1>(m, "RectangularGridGraph__1");
     rectangular_grid_graph<2>(m, "RectangularGridGraph__2");
+
+    // Grid graphs with narrow (32-bit) and wide (64-bit) vertex & edge indices.
+    rectangular_grid_graph<1, std::uint32_t>(m, "RectangularGridGraph__1_u32");
+    rectangular_grid_graph<1, std::uint64_t>(m, "RectangularGridGraph__1_u64");
 }
 
 } // namespace whirlwind::bindings
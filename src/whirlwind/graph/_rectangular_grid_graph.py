@@ -1,5 +1,8 @@
 from collections.abc import Iterable
 
+import numpy as np
+from numpy.typing import DTypeLike
+
 from . import _lib
 
 __all__ = [
@@ -7,7 +10,35 @@ __all__ = [
 ]
 
 
-def _make_rectangular_grid_graph_impl(num_rows, num_cols, num_parallel_edges):  # type: ignore[no-untyped-def]
+def _fits_narrow_index(num_rows, num_cols):  # type: ignore[no-untyped-def]
+    # Each edge gives rise to a forward and a reverse arc in the residual graph of a
+    # network, and arcs are indexed by the same type as edges.
+    num_edges = 2 * (num_rows * (num_cols - 1) + (num_rows - 1) * num_cols)
+    return 2 * num_edges <= np.iinfo(np.uint32).max
+
+
+def _make_rectangular_grid_graph_impl(  # type: ignore[no-untyped-def]
+    num_rows, num_cols, num_parallel_edges, index_dtype
+):
+    if index_dtype is not None:
+        if num_parallel_edges != 1:
+            raise ValueError("index_dtype requires num_parallel_edges=1")
+
+        if isinstance(index_dtype, str) and index_dtype == "auto":
+            narrow = _fits_narrow_index(num_rows, num_cols)
+            index_dtype = np.uint32 if narrow else np.uint64
+
+        index_dtype = np.dtype(index_dtype)
+        if index_dtype == np.uint32:
+            if not _fits_narrow_index(num_rows, num_cols):
+                raise ValueError("graph is too large for 32-bit indices")
+            cls = _lib.RectangularGridGraph__1_u32
+        elif index_dtype == np.uint64:
+            cls = _lib.RectangularGridGraph__1_u64
+        else:
+            raise ValueError("index_dtype must be uint32, uint64, 'auto' or None")
+        return cls(num_rows=num_rows, num_cols=num_cols)
+
     if num_parallel_edges == 1:
         return _lib.RectangularGridGraph__1(num_rows=num_rows, num_cols=num_cols)
     if num_parallel_edges == 2:
@@ -28,7 +59,13 @@ class RectangularGridGraph:
     Vertex = tuple[int, int]
     Edge = int
 
-    def __init__(self, num_rows: int, num_cols: int, num_parallel_edges: int = 1):
+    def __init__(
+        self,
+        num_rows: int,
+        num_cols: int,
+        num_parallel_edges: int = 1,
+        index_dtype: DTypeLike | str | None = None,
+    ):
         """
         Create a new `RectangularGridGraph`.
 
@@ -41,9 +78,18 @@ class RectangularGridGraph:
         num_parallel_edges : int, optional
             The number of parallel edges between adjacent vertices in the graph. Must be
             1 or 2. Defaults to 1.
+        index_dtype : data-type, 'auto' or None, optional
+            The unsigned integer type used to index vertices and edges: `numpy.uint32`
+            or `numpy.uint64`. Narrow indices reduce the memory footprint of networks
+            and solvers over the graph but limit its size. If 'auto', 32-bit indices
+            are used if they can index every arc in the residual graph of a network
+            over the graph, and 64-bit indices otherwise. Only supported if
+            `num_parallel_edges` is 1. If None, the default index type is used.
+            `whirlwind.unwrap` and `whirlwind.unwrap_stack` use 'auto'. Defaults to
+            None.
         """
         self._impl = _make_rectangular_grid_graph_impl(
-            num_rows, num_cols, num_parallel_edges
+            num_rows, num_cols, num_parallel_edges, index_dtype
         )  # type: ignore[no-untyped-call]
 
     @property
@@ -168,5 +214,50 @@ class RectangularGridGraph:
         """
         return self._impl.outgoing_edges(vertex)
 
+    def outdegree_array(self) -> np.ndarray:
+        """
+        Get the outdegree of every vertex in the graph.
+
+        Returns
+        -------
+        numpy.ndarray
+            A 1-D array containing the number of outgoing edges of each vertex, indexed
+            by vertex index.
+        """
+        return self._impl.outdegree_array()
+
+    def edge_array(self) -> np.ndarray:
+        """
+        Get the tail and head vertex indices of every edge in the graph.
+
+        Returns
+        -------
+        numpy.ndarray
+            An E x 2 array, where E is the total number of edges, whose i-th row
+            contains the indices of the tail and head vertices of the edge with index
+            i.
+        """
+        return self._impl.edge_array()
+
+    def csr_arrays(self) -> tuple[np.ndarray, np.ndarray, np.ndarray]:
+        """
+        Get the adjacency structure of the graph in compressed sparse row format.
+
+        The outgoing edges of the vertex with index `i` are stored in the range
+        ``indptr[i]:indptr[i+1]`` of `indices` and `edge_ids`. The first two outputs
+        are compatible with `scipy.sparse.csr_array`.
+
+        Returns
+        -------
+        indptr : numpy.ndarray
+            The offset of each vertex's outgoing edges. Its length is V + 1, where V
+            is the total number of vertices.
+        indices : numpy.ndarray
+            The head vertex index of each outgoing edge.
+        edge_ids : numpy.ndarray
+            The edge index of each outgoing edge.
+        """
+        return self._impl.csr_arrays()
+
     def __repr__(self) -> str:
         return repr(self._impl)
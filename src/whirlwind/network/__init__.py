@@ -1,9 +1,12 @@
 from ._network import Network
+from ._piecewise_linear import piecewise_linear_edge_flows, piecewise_linear_network
 from ._primal_dual import primal_dual
 from ._successive_shortest_paths import successive_shortest_paths
 
 __all__ = [
     "Network",
+    "piecewise_linear_edge_flows",
+    "piecewise_linear_network",
     "primal_dual",
     "successive_shortest_paths",
 ]
@@ -1,17 +1,24 @@
 #include <cstdint>
 #include <span>
+#include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
 
+#include <whirlwind/common/stddef.hpp>
 #include <whirlwind/common/type_traits.hpp>
 #include <whirlwind/common/vector.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
 #include <whirlwind/network/network.hpp>
 #include <whirlwind/network/uncapacitated.hpp>
 #include <whirlwind/network/unit_capacity.hpp>
 
+#include "array.hpp"
+#include "index_types.hpp"
 #include "iterable.hpp"
 
 namespace whirlwind::bindings {
@@ -65,6 +72,49 @@ network_attrs_and_methods(nb::class_<Class, Extra...>& cls)
     cls.def("arc_reduced_cost", &Class::arc_reduced_cost, "arc"_a, "tail"_a, "head"_a);
     cls.def("total_cost", &Class::total_cost, nb::call_guard<nb::gil_scoped_release>());
 
+    // Bulk accessors for the flow in the forward arc corresponding to each edge in the
+    // original graph, indexed by edge index.
+    cls.def("edge_flow_array", [](const Class& self) {
+        auto flow = [&]() {
+            [[maybe_unused]] const nb::gil_scoped_release nogil;
+            const auto num_edges = static_cast<Size>(self.num_forward_arcs());
+            auto out = std::vector<Flow>(num_edges);
+            for (Size edge = 0; edge < num_edges; ++edge) {
+                out[edge] = self.arc_flow(self.get_residual_graph_arc_id(edge));
+            }
+            return out;
+        }();
+
+        return to_numpy_array(std::move(flow));
+    });
+    cls.def(
+            "increase_edge_flows",
+            [](Class& self, const PyArray1D<const Flow>& delta) {
+                const auto num_edges = static_cast<Size>(self.num_forward_arcs());
+                if (delta.size() != num_edges) {
+                    throw std::invalid_argument(
+                            "delta must have one entry per edge in the graph");
+                }
+
+                const auto* delta_data = delta.data();
+                [[maybe_unused]] const nb::gil_scoped_release nogil;
+
+                // Check every entry before modifying any flows, so that the network is
+                // left unchanged if the input is invalid.
+                for (Size edge = 0; edge < num_edges; ++edge) {
+                    if (delta_data[edge] < Flow{0}) {
+                        throw std::invalid_argument("delta must be non-negative");
+                    }
+                }
+                for (Size edge = 0; edge < num_edges; ++edge) {
+                    if (delta_data[edge] > Flow{0}) {
+                        self.increase_arc_flow(self.get_residual_graph_arc_id(edge),
+                                               delta_data[edge]);
+                    }
+                }
+            },
+            "delta"_a);
+
     using ExcessNodes = remove_cvref_t<decltype(std::declval<Class>().excess_nodes())>;
     using DeficitNodes =
             remove_cvref_t<decltype(std::declval<Class>().deficit_nodes())>;
@@ -131,7 +181,14 @@ network(nb::module_& m, const std::string& name)
 void
 network(nb::module_& m)
 {
+    network<CSRGraph<>>(m, "Network__CSRGraph");
     network<RectangularGridGraph<>>(m, "Network__RectangularGridGraph");
+    network<RectangularGridGraph<2>>(m, "Network__RectangularGridGraph__2");
+
+    for_each_grid_graph_index_variant(
+            [&]<class Graph>(std::type_identity<Graph>, const std::string& suffix) {
+                network<Graph>(m, "Network__RectangularGridGraph" + suffix);
+            });
 }
 
 } // namespace whirlwind::bindings
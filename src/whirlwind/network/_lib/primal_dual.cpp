@@ -1,10 +1,13 @@
 #include <cstdint>
+#include <string>
 
 #include <nanobind/nanobind.h>
 
 #include <whirlwind/common/vector.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
 #include <whirlwind/graph/dial.hpp>
 #include <whirlwind/graph/dijkstra.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
 #include <whirlwind/logging/null_logger.hpp>
 #include <whirlwind/network/network.hpp>
 #include <whirlwind/network/primal_dual.hpp>
@@ -12,6 +15,8 @@
 #include <whirlwind/network/uncapacitated.hpp>
 #include <whirlwind/network/unit_capacity.hpp>
 
+#include "index_types.hpp"
+
 namespace whirlwind::bindings {
 
 namespace nb = nanobind;
@@ -92,7 +97,19 @@ primal_dual(nb::module_& m)
 void
 primal_dual(nb::module_& m)
 {
+    // Dial's algorithm is not supported for `CSRGraph`, so only Dijkstra's algorithm is
+    // used to find shortest paths in its residual graph.
+    using CSRResidualGraph = ResidualGraphTraits<CSRGraph<>>::type;
+    using CSRDijkstra = Dijkstra<std::int32_t, CSRResidualGraph>;
+    primal_dual<CSRGraph<>, std::int32_t, CSRDijkstra>(m);
+
     primal_dual<RectangularGridGraph<>>(m);
+    primal_dual<RectangularGridGraph<2>>(m);
+
+    for_each_grid_graph_index_variant(
+            [&]<class Graph>(std::type_identity<Graph>, const std::string&) {
+                primal_dual<Graph>(m);
+            });
 }
 
 } // namespace whirlwind::bindings
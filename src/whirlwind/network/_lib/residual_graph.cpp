@@ -4,9 +4,11 @@
 #include <nanobind/nanobind.h>
 
 #include <whirlwind/common/type_traits.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
 #include <whirlwind/graph/rectangular_grid_graph.hpp>
 #include <whirlwind/network/residual_graph.hpp>
 
+#include "index_types.hpp"
 #include "iterable.hpp"
 
 namespace whirlwind::bindings {
@@ -86,8 +88,17 @@ residual_graph(nb::module_& m, const std::string& name)
 void
 residual_graph(nb::module_& m)
 {
+    residual_graph<CSRGraph<>>(m, "ResidualGraphMixin__CSRGraph");
     residual_graph<RectangularGridGraph<>>(m,
                                            "ResidualGraphMixin__RectangularGridGraph");
+    residual_graph<RectangularGridGraph<2>>(
+            m, "ResidualGraphMixin__RectangularGridGraph__2");
+
+    for_each_grid_graph_index_variant(
+            [&]<class Graph>(std::type_identity<Graph>, const std::string& suffix) {
+                const auto name = "ResidualGraphMixin__RectangularGridGraph" + suffix;
+                residual_graph<Graph>(m, name);
+            });
 }
 
 } // namespace whirlwind::bindings
@@ -1,12 +1,16 @@
 #include <cstdint>
+#include <string>
 
 #include <nanobind/nanobind.h>
 
 #include <whirlwind/common/vector.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
 #include <whirlwind/network/residual_graph.hpp>
 #include <whirlwind/network/uncapacitated.hpp>
 
 #include "capacity.hpp"
+#include "index_types.hpp"
 
 namespace whirlwind::bindings {
 
@@ -27,8 +31,17 @@ uncapacitated(nb::module_& m, const char* name)
 void
 uncapacitated(nb::module_& m)
 {
+    uncapacitated<CSRGraph<>>(m, "UncapacitatedMixin__CSRGraph");
     uncapacitated<RectangularGridGraph<>>(m,
                                           "UncapacitatedMixin__RectangularGridGraph");
+    uncapacitated<RectangularGridGraph<2>>(
+            m, "UncapacitatedMixin__RectangularGridGraph__2");
+
+    for_each_grid_graph_index_variant(
+            [&]<class Graph>(std::type_identity<Graph>, const std::string& suffix) {
+                const auto name = "UncapacitatedMixin__RectangularGridGraph" + suffix;
+                uncapacitated<Graph>(m, name.c_str());
+            });
 }
 
 } // namespace whirlwind::bindings
@@ -1,12 +1,16 @@
 #include <cstdint>
+#include <string>
 
 #include <nanobind/nanobind.h>
 
 #include <whirlwind/common/vector.hpp>
+#include <whirlwind/graph/csr_graph.hpp>
+#include <whirlwind/graph/rectangular_grid_graph.hpp>
 #include <whirlwind/network/residual_graph.hpp>
 #include <whirlwind/network/unit_capacity.hpp>
 
 #include "capacity.hpp"
+#include "index_types.hpp"
 
 namespace whirlwind::bindings {
 
@@ -27,7 +31,16 @@ unit_capacity(nb::module_& m, const char* name)
 void
 unit_capacity(nb::module_& m)
 {
+    unit_capacity<CSRGraph<>>(m, "UnitCapacityMixin__CSRGraph");
     unit_capacity<RectangularGridGraph<>>(m, "UnitCapacityMixin__RectangularGridGraph");
+    unit_capacity<RectangularGridGraph<2>>(
+            m, "UnitCapacityMixin__RectangularGridGraph__2");
+
+    for_each_grid_graph_index_variant(
+            [&]<class Graph>(std::type_identity<Graph>, const std::string& suffix) {
+                const auto name = "UnitCapacityMixin__RectangularGridGraph" + suffix;
+                unit_capacity<Graph>(m, name.c_str());
+            });
 }
 
 } // namespace whirlwind::bindings
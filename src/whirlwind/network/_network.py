@@ -6,7 +6,8 @@ from typing import Generic, TypeVar
 import numpy as np
 from numpy.typing import ArrayLike
 
-from whirlwind.graph import RectangularGridGraph
+from whirlwind.graph import CSRGraph, RectangularGridGraph
+from whirlwind.graph import _lib as _graph_lib
 
 from . import _lib
 
@@ -24,9 +25,27 @@ Cost = TypeVar("Cost")
 Flow = TypeVar("Flow")
 
 
-def _make_network_impl(graph, surplus, cost, capacity):  # type: ignore[no-untyped-def]
-    if type(graph) != RectangularGridGraph:
+def _get_graph_type_name(graph):  # type: ignore[no-untyped-def]
+    if isinstance(graph, RectangularGridGraph):
+        # Explicit index types that coincide with the default one are aliases of the
+        # default graph type, so the default is checked first.
+        impl_type = type(graph._impl)
+        if impl_type is _graph_lib.RectangularGridGraph__1:
+            return "RectangularGridGraph"
+        if impl_type is _graph_lib.RectangularGridGraph__2:
+            return "RectangularGridGraph__2"
+        if impl_type is _graph_lib.RectangularGridGraph__1_u32:
+            return "RectangularGridGraph_u32"
+        if impl_type is _graph_lib.RectangularGridGraph__1_u64:
+            return "RectangularGridGraph_u64"
         raise NotImplementedError
+    if isinstance(graph, CSRGraph):
+        return "CSRGraph"
+    raise NotImplementedError
+
+
+def _make_network_impl(graph, surplus, cost, capacity):  # type: ignore[no-untyped-def]
+    graph_type_name = _get_graph_type_name(graph)  # type: ignore[no-untyped-call]
 
     # FIXME
     surplus = np.asanyarray(surplus)
@@ -35,23 +54,23 @@ def _make_network_impl(graph, surplus, cost, capacity):  # type: ignore[no-untyp
     if not np.issubdtype(surplus.dtype, np.integer):
         raise TypeError
 
+    if np.issubdtype(cost.dtype, np.floating):
+        cost_type_name = "f32"
+    elif np.issubdtype(cost.dtype, np.integer):
+        cost_type_name = "i32"
+    else:
+        raise TypeError
+
     if capacity is None:
-        if np.issubdtype(cost.dtype, np.floating):
-            cls = _lib.Network__RectangularGridGraph_f32_i32_vector_Uncapacitated
-        elif np.issubdtype(cost.dtype, np.integer):
-            cls = _lib.Network__RectangularGridGraph_i32_i32_vector_Uncapacitated
-        else:
-            raise TypeError
+        mixin_name = "Uncapacitated"
     elif capacity == 1:
-        if np.issubdtype(cost.dtype, np.floating):
-            cls = _lib.Network__RectangularGridGraph_f32_i32_vector_UnitCapacity
-        elif np.issubdtype(cost.dtype, np.integer):
-            cls = _lib.Network__RectangularGridGraph_i32_i32_vector_UnitCapacity
-        else:
-            raise TypeError
+        mixin_name = "UnitCapacity"
     else:
         raise NotImplementedError
 
+    cls = getattr(
+        _lib, f"Network__{graph_type_name}_{cost_type_name}_i32_vector_{mixin_name}"
+    )
     return cls(graph=graph._impl, surplus=surplus, cost=cost)
 
 
@@ -324,6 +343,43 @@ class Network(Generic[ResidualGraph, Cost, Flow]):
         """
         self._impl.increase_arc_flow(arc, delta)
 
+    def edge_flow_array(self) -> np.ndarray:
+        """
+        Get the amount of flow along every edge in the original graph.
+
+        Returns
+        -------
+        numpy.ndarray
+            A 1-D array containing the flow in the forward arc corresponding to each
+            edge in the original graph, indexed by edge index.
+        """
+        return self._impl.edge_flow_array()
+
+    def increase_edge_flows(self, delta: ArrayLike) -> None:
+        """
+        Increase flow along every edge in the original graph.
+
+        For each edge with index `i`, adds ``delta[i]`` units of flow to the
+        corresponding forward arc in the residual graph, as if by `increase_arc_flow`.
+        Edges whose entry is zero are left unmodified. Does not modify the
+        excess/deficit of any node. The Python GIL is released while the flows are
+        updated.
+
+        Parameters
+        ----------
+        delta : array_like
+            A 1-D array of non-negative integers with one entry per edge in the
+            original graph. Each entry must be <= the residual capacity of the
+            corresponding arc.
+
+        Raises
+        ------
+        ValueError
+            If `delta` does not have one entry per edge, or if any entry is negative.
+            The network is left unmodified.
+        """
+        self._impl.increase_edge_flows(np.ascontiguousarray(delta, dtype=np.int32))
+
     def node_excess(self, node: Node) -> Flow:
         return self._impl.node_excess(node)
 
@@ -0,0 +1,157 @@
+from __future__ import annotations
+
+import warnings
+
+import numpy as np
+from numpy.typing import ArrayLike
+
+from whirlwind.graph import CSRGraph, RectangularGridGraph
+
+from ._network import Network
+
+__all__ = [
+    "piecewise_linear_edge_flows",
+    "piecewise_linear_network",
+]
+
+
+def _get_parallel_edge_ids(  # type: ignore[no-untyped-def]
+    graph, parallel_graph
+):
+    """
+    Get the index of each parallel edge corresponding to each edge in `graph`.
+
+    Returns a K x E array, where K is the number of parallel edges in `parallel_graph`
+    and E is the number of edges in `graph`, whose (k,i)-th entry is the index of the
+    k-th edge in `parallel_graph` with the same tail & head vertices as the edge with
+    index i in `graph`. Parallel edges are ordered by edge index.
+    """
+    num_vertices = graph.num_vertices
+    edges = graph.edge_array().astype(np.int64)
+    keys = edges[:, 0] * num_vertices + edges[:, 1]
+
+    parallel_edges = parallel_graph.edge_array().astype(np.int64)
+    parallel_keys = parallel_edges[:, 0] * num_vertices + parallel_edges[:, 1]
+    order = np.argsort(parallel_keys, kind="stable")
+
+    first = np.searchsorted(parallel_keys[order], keys)
+    segments = np.arange(parallel_graph.num_parallel_edges)
+    return order[first + segments[:, None]]
+
+
+def piecewise_linear_network(
+    graph: RectangularGridGraph, surplus: ArrayLike, segment_costs: ArrayLike
+) -> Network:
+    """
+    Create a network whose edge costs are convex piecewise-linear functions of flow.
+
+    Each edge in `graph` is replaced by K parallel unit-capacity edges, one per segment
+    of its cost function. The k-th unit of flow along the edge costs
+    ``segment_costs[k-1]``. Since the segment costs are non-decreasing, a minimum cost
+    flow fills the cheaper segments first, so the total cost of each edge is a convex
+    piecewise-linear function of its flow, with breakpoints at integer flows.
+
+    For K of 1 or 2, the parallel edges are stored in a single `RectangularGridGraph`
+    with ``num_parallel_edges=K``, so the adjacency structure of each segment is never
+    materialized. Grid graphs with more parallel edges are not available, so for larger
+    K the network falls back to a `CSRGraph` that stores K explicit copies of every
+    edge, and a warning is emitted. The fallback solves the same problem, but its
+    graph takes memory proportional to K times the number of edges, and its solves
+    are slower than those of the grid-graph network. Either network may be solved by
+    `primal_dual`.
+
+    Parameters
+    ----------
+    graph : RectangularGridGraph
+        The input graph. Must have a single edge between each pair of adjacent
+        vertices.
+    surplus : array_like
+        The surplus of each vertex, indexed by vertex index.
+    segment_costs : array_like
+        A K x E array of integers, where K is at least 1 and E is the total number of
+        edges in `graph`, containing the cost per unit of flow of each segment of each
+        edge's cost function, indexed by segment and edge index. Must be non-decreasing
+        along the first axis, and representable as 32-bit signed integers.
+
+    Returns
+    -------
+    Network
+        A unit-capacity network with K parallel edges between each pair of adjacent
+        vertices of `graph`.
+
+    See Also
+    --------
+    piecewise_linear_edge_flows
+    """
+    if graph.num_parallel_edges != 1:
+        raise ValueError("graph must have a single edge between adjacent vertices")
+
+    segment_costs = np.asarray(segment_costs)
+    if segment_costs.ndim != 2 or segment_costs.shape[1] != graph.num_edges:
+        raise ValueError("segment_costs must be a K x E array")
+    if not np.issubdtype(segment_costs.dtype, np.integer):
+        raise TypeError("segment_costs must be an array of integers")
+    if segment_costs.shape[0] < 1:
+        raise ValueError("segment_costs must have at least one segment")
+    if np.any(np.diff(segment_costs, axis=0) < 0):
+        raise ValueError("segment costs must be non-decreasing (convex)")
+
+    # The network stores integer costs as 32-bit signed integers.
+    info = np.iinfo(np.int32)
+    if segment_costs.size and (
+        segment_costs.min() < info.min or segment_costs.max() > info.max
+    ):
+        raise ValueError("segment costs must be representable as 32-bit integers")
+
+    num_segments = segment_costs.shape[0]
+    if num_segments <= 2 or graph.num_edges == 0:
+        parallel_graph = RectangularGridGraph(
+            graph.num_rows, graph.num_cols, num_parallel_edges=min(num_segments, 2)
+        )
+        edge_ids = _get_parallel_edge_ids(graph, parallel_graph)
+        # A graph without edges has no parallel edges to assign segments to.
+        edge_ids = edge_ids.reshape(num_segments, graph.num_edges)
+    else:
+        warnings.warn(
+            f"piecewise_linear_network with {num_segments} segments falls back to a"
+            " CSRGraph with an explicit copy of each edge per segment, which uses more"
+            " memory and is slower to solve than the grid graph used for at most 2"
+            " segments",
+            stacklevel=2,
+        )
+        edges = graph.edge_array()
+        parallel_graph, edge_ids = CSRGraph.from_edge_arrays(
+            np.tile(edges[:, 0], num_segments),
+            np.tile(edges[:, 1], num_segments),
+            num_vertices=graph.num_vertices,
+        )
+        edge_ids = edge_ids.reshape(num_segments, graph.num_edges)
+
+    cost = np.empty(parallel_graph.num_edges, dtype=np.int32)
+    cost[edge_ids] = segment_costs
+    network = Network(parallel_graph, surplus, cost, capacity=1)
+
+    # Keep the parallel edges of each input edge for `piecewise_linear_edge_flows()`.
+    network._segment_edge_ids = edge_ids  # type: ignore[attr-defined]
+    return network
+
+
+def piecewise_linear_edge_flows(network: Network) -> np.ndarray:
+    """
+    Sum the flows in the parallel edges of a piecewise-linear network.
+
+    Parameters
+    ----------
+    network : Network
+        A network returned by `piecewise_linear_network`.
+
+    Returns
+    -------
+    numpy.ndarray
+        A 1-D array containing the total flow along each edge of the graph that was
+        passed to `piecewise_linear_network`, indexed by edge index.
+    """
+    edge_ids = getattr(network, "_segment_edge_ids", None)
+    if edge_ids is None:
+        raise ValueError("network must be returned by piecewise_linear_network")
+    return network.edge_flow_array()[edge_ids].sum(axis=0)
@@ -2,10 +2,13 @@ from ._cubic_b_spline import CubicBSpline
 from ._cubic_b_spline_2d import BiCubicBSpline
 from ._cubic_b_spline_3d import TriCubicBSpline
 from ._cubic_b_spline_basis import CubicBSplineBasis
+from ._spline_file import load_samples, save_samples
 
 __all__ = [
     "BiCubicBSpline",
     "CubicBSpline",
     "CubicBSplineBasis",
     "TriCubicBSpline",
+    "load_samples",
+    "save_samples",
 ]
@@ -1,11 +1,12 @@
-from typing import TypeVar
+from collections.abc import Sequence
+from typing import Optional, TypeVar
 
 import numpy as np
 from numpy.typing import ArrayLike
-from scipy.linalg.lapack import dgtsv
 
 from . import _lib
 from ._cubic_b_spline_basis import CubicBSplineBasis
+from ._spline_file import PathLike, _load_impl
 
 __all__ = [
     "CubicBSpline",
@@ -15,6 +16,29 @@ __all__ = [
 CubicBSplineT = TypeVar("CubicBSplineT", bound="CubicBSpline")
 
 
+def _check_out_array(out: np.ndarray, shape: tuple[int, ...], dtype: np.dtype) -> None:
+    """
+    Check that `out` can store the results of evaluating a spline in place.
+
+    `out` must be a writeable, C-contiguous array with the given shape whose data type
+    is either `dtype` (the data type of the spline's control points) or float32.
+    Otherwise, the results would be written to a temporary copy rather than to `out`,
+    so a ValueError is raised instead.
+    """
+    if not isinstance(out, np.ndarray):
+        raise ValueError("out must be a numpy.ndarray")
+    if out.dtype not in (dtype, np.dtype(np.float32)):
+        msg = f"out must have data type {dtype} or float32, got {out.dtype}"
+        raise ValueError(msg)
+    if out.shape != shape:
+        msg = f"out must have shape {shape}, got {out.shape}"
+        raise ValueError(msg)
+    if not out.flags.c_contiguous:
+        raise ValueError("out must be C-contiguous")
+    if not out.flags.writeable:
+        raise ValueError("out must be writeable")
+
+
 def _make_cubic_b_spline_impl(basis, control_points):  # type: ignore[no-untyped-def]
     control_points = np.ascontiguousarray(control_points)
     if control_points.dtype == np.float32:
@@ -34,67 +58,43 @@ class CubicBSpline:
         """ """
 
         basis = CubicBSplineBasis(knots)
+        control_points = basis.interpolate_control_points(values)
+        return cls(basis, control_points)
 
-        knots = basis.knots
-        values = np.asanyarray(values)
-
-        du = []
-        d = []
-        dl = []
-        b = []
-
-        d0, du0, c0, _ = basis.eval_second_derivative_in_interval(knots[0], 0)
-
-        dl1, d1, du1, _ = basis.eval_in_interval(knots[0], 0)
-
-        # Row reduction (first row)
-        d0 -= c0 * dl1 / du1
-        du0 -= c0 * d1 / du1
-        b0 = -c0 * values[0] / du1
-
-        du.append(du0)
-        d.append(d0)
-        b.append(b0)
-
-        dl.append(dl1)
-        d.append(d1)
-        du.append(du1)
-        b.append(values[0])
-
-        for i in range(1, len(knots) - 1):
-            dl2, d2, du2, _ = basis.eval_in_interval(knots[i], i)
-            dl.append(dl2)
-            d.append(d2)
-            du.append(du2)
-            b.append(values[i])
-
-        _, dl3, d3, du3 = basis.eval_in_interval(knots[-1], len(knots) - 2)
-        dl.append(dl3)
-        d.append(d3)
-        du.append(du3)
-        b.append(values[-1])
-
-        _, c1, dl4, d4 = basis.eval_second_derivative_in_interval(
-            knots[-1], len(knots) - 2
+    @classmethod
+    def load(cls: type[CubicBSplineT], path: PathLike) -> CubicBSplineT:
+        """
+        Load a spline from a file written by `CubicBSpline.save`.
+
+        Parameters
+        ----------
+        path : str or os.PathLike
+            The path of the input file.
+
+        Returns
+        -------
+        CubicBSpline
+            The loaded spline.
+        """
+        obj = cls.__new__(cls)
+        obj._impl = _load_impl(
+            path, _lib.CubicBSpline__f32, _lib.CubicBSpline__f64
         )
+        return obj
 
-        # Row reduction (last row)
-        dl4 -= c1 * d3 / dl3
-        d4 -= c1 * du3 / dl3
-        b1 = -c1 * values[-1] / dl3
-
-        dl.append(dl4)
-        d.append(d4)
-        b.append(b1)
+    def save(self, path: PathLike) -> None:
+        """
+        Save the spline to a file.
 
-        du = np.asarray(du)
-        d = np.asarray(d)
-        dl = np.asarray(dl)
-        b = np.asarray(b)
+        The file stores the knots and control points as raw binary arrays. It can be
+        read back with `CubicBSpline.load`.
 
-        _, _, _, control_points, _ = dgtsv(dl, d, du, b)
-
-        return cls(basis, control_points)
+        Parameters
+        ----------
+        path : str or os.PathLike
+            The path of the output file. An existing file is overwritten.
+        """
+        self._impl.save(path)
 
     @property
     def knots(self) -> np.ndarray:
@@ -106,6 +106,71 @@ class CubicBSpline:
         """ """
         return self._impl.control_points
 
-    def __call__(self, x: float) -> float:
+    def evaluate(
+        self,
+        x: ArrayLike,
+        derivatives: Sequence[int] = (0, 1),
+        *,
+        out: Optional[np.ndarray] = None,
+        num_threads: int = 0,
+    ) -> np.ndarray:
+        """
+        Evaluate the spline and its derivatives at a batch of points.
+
+        All requested derivatives are computed together in a single pass over the
+        control points surrounding each point, which is faster than evaluating them
+        separately. The Python GIL is released during evaluation.
+
+        Parameters
+        ----------
+        x : array_like
+            The coordinates of the points to evaluate.
+        derivatives : sequence of int, optional
+            The derivatives to evaluate. Each element is the order of the
+            derivative, where 0 denotes the value of the spline. Orders up to 2 are
+            supported. Defaults to ``(0, 1)`` (the value and first derivative).
+        out : numpy.ndarray or None, optional
+            A C-contiguous array to store the results in. It must have the shape of the
+            result and the same data type as the spline, or float32. If None, a new
+            array is allocated. Defaults to None.
+        num_threads : int, optional
+            The number of worker threads to use. If zero, the number of concurrent
+            threads supported by the hardware is used. Defaults to 0.
+
+        Returns
+        -------
+        numpy.ndarray
+            The results, stacked along the first axis in the order given by
+            `derivatives`. The remaining axes have the broadcast shape of the input
+            coordinates. If `out` was provided, it is returned.
+        """
+        derivatives = [int(order) for order in derivatives]
+        if any(order < 0 or order > 2 for order in derivatives):
+            raise ValueError("derivative orders must be in the range [0, 2]")
+        x = np.asarray(x)
+        if out is not None:
+            shape = (len(derivatives), *x.shape)
+            _check_out_array(out, shape, self.control_points.dtype)
+            self._impl.evaluate(
+                x, derivatives=derivatives, out=out, num_threads=num_threads
+            )
+            return out
+        return self._impl.evaluate(x, derivatives=derivatives, num_threads=num_threads)
+
+    def __call__(
+        self,
+        x: float,
+        *,
+        out: Optional[np.ndarray] = None,
+        num_threads: int = 0,
+    ) -> float:
         """ """
-        return self._impl(x)
+        if out is None and np.ndim(x) == 0:
+            return self._impl(x)
+
+        x = np.asarray(x)
+        if out is not None:
+            _check_out_array(out, x.shape, self.control_points.dtype)
+            self._impl(x, out=out, num_threads=num_threads)
+            return out  # type: ignore[return-value]
+        return self._impl(x, num_threads=num_threads)
@@ -1,11 +1,13 @@
-from typing import TypeVar
+from collections.abc import Sequence
+from typing import Optional, TypeVar
 
 import numpy as np
 from numpy.typing import ArrayLike
 
 from . import _lib
-from ._cubic_b_spline import CubicBSpline
+from ._cubic_b_spline import _check_out_array
 from ._cubic_b_spline_basis import CubicBSplineBasis
+from ._spline_file import PathLike, _load_impl
 
 __all__ = [
     "BiCubicBSpline",
@@ -41,27 +43,52 @@ class BiCubicBSpline:
         basis0 = CubicBSplineBasis(knots[0])
         basis1 = CubicBSplineBasis(knots[1])
 
-        knots0 = basis0.knots
-        knots1 = basis1.knots
         values = np.asanyarray(values)
-
-        m = len(knots0)
-        n = len(knots1)
-
         dtype = np.common_type(values)
 
-        tmp = np.zeros_like(values, dtype=dtype, shape=(m, n + 2))
-        for i in range(m):
-            spline = CubicBSpline.interpolate(knots1, values[i, :])
-            tmp[i, :] = spline.control_points
-
-        control_points = np.zeros_like(tmp, shape=(m + 2, n + 2))
-        for j in range(n + 2):
-            spline = CubicBSpline.interpolate(knots0, tmp[:, j])
-            control_points[:, j] = spline.control_points
+        # Fit each axis in turn. Each pass solves a batch of 1-D interpolation problems
+        # along one axis of the output of the previous pass.
+        tmp = basis1.interpolate_control_points(values, axis=1)
+        control_points = basis0.interpolate_control_points(tmp, axis=0)
+        control_points = control_points.astype(dtype, copy=False)
 
         return cls((basis0, basis1), control_points)
 
+    @classmethod
+    def load(cls: type[BiCubicBSplineT], path: PathLike) -> BiCubicBSplineT:
+        """
+        Load a spline from a file written by `BiCubicBSpline.save`.
+
+        Parameters
+        ----------
+        path : str or os.PathLike
+            The path of the input file.
+
+        Returns
+        -------
+        BiCubicBSpline
+            The loaded spline.
+        """
+        obj = cls.__new__(cls)
+        obj._impl = _load_impl(
+            path, _lib.BiCubicBSpline__f32, _lib.BiCubicBSpline__f64
+        )
+        return obj
+
+    def save(self, path: PathLike) -> None:
+        """
+        Save the spline to a file.
+
+        The file stores the knots and control points as raw binary arrays. It can be
+        read back with `BiCubicBSpline.load`.
+
+        Parameters
+        ----------
+        path : str or os.PathLike
+            The path of the output file. An existing file is overwritten.
+        """
+        self._impl.save(path)
+
     @property
     def knots(self) -> tuple[np.ndarray, np.ndarray]:
         """ """
@@ -72,6 +99,87 @@ class BiCubicBSpline:
         """ """
         return self._impl.control_points
 
-    def __call__(self, x0: float, x1: float) -> float:
+    def evaluate(
+        self,
+        x0: ArrayLike,
+        x1: ArrayLike,
+        derivatives: Sequence[tuple[int, int]] = (
+            (0, 0),
+            (1, 0),
+            (0, 1),
+        ),
+        *,
+        out: Optional[np.ndarray] = None,
+        num_threads: int = 0,
+    ) -> np.ndarray:
+        """
+        Evaluate the spline and its derivatives at a batch of points.
+
+        All requested derivatives are computed together in a single pass over the
+        control points surrounding each point, which is faster than evaluating them
+        separately. The Python GIL is released during evaluation.
+
+        Parameters
+        ----------
+        x0 : array_like
+            The coordinates of the points along axis 0.
+        x1 : array_like
+            The coordinates of the points along axis 1. The coordinates along each axis
+            are broadcast against each other.
+        derivatives : sequence of tuple of int, optional
+            The derivatives to evaluate. Each element is a 2-tuple containing the
+            order of the partial derivative along each axis, where all zeros denotes the
+            value of the spline. Orders up to 2 along each axis are supported. Defaults
+            to the value and gradient.
+        out : numpy.ndarray or None, optional
+            A C-contiguous array to store the results in. It must have the shape of the
+            result and the same data type as the spline, or float32. If None, a new
+            array is allocated. Defaults to None.
+        num_threads : int, optional
+            The number of worker threads to use. If zero, the number of concurrent
+            threads supported by the hardware is used. Defaults to 0.
+
+        Returns
+        -------
+        numpy.ndarray
+            The results, stacked along the first axis in the order given by
+            `derivatives`. The remaining axes have the broadcast shape of the input
+            coordinates. If `out` was provided, it is returned.
+        """
+        derivatives = [tuple(int(order) for order in orders) for orders in derivatives]
+        if any(len(orders) != 2 for orders in derivatives):
+            raise ValueError("each element of derivatives must have length 2")
+        if any(order < 0 or order > 2 for orders in derivatives for order in orders):
+            raise ValueError("derivative orders must be in the range [0, 2]")
+        args = (np.asarray(x0), np.asarray(x1))
+        if out is not None:
+            shape = (len(derivatives), *np.broadcast_shapes(*(x.shape for x in args)))
+            _check_out_array(out, shape, self.control_points.dtype)
+            self._impl.evaluate(
+                *args, derivatives=derivatives, out=out, num_threads=num_threads
+            )
+            return out
+        return self._impl.evaluate(
+            *args, derivatives=derivatives, num_threads=num_threads
+        )
+
+    def __call__(
+        self,
+        x0: float,
+        x1: float,
+        *,
+        out: Optional[np.ndarray] = None,
+        num_threads: int = 0,
+    ) -> float:
         """ """
-        return self._impl(x0, x1)
+        if out is None and np.ndim(x0) == 0 and np.ndim(x1) == 0:
+            return self._impl(x0, x1)
+
+        # Array arguments are broadcast against each other without being expanded.
+        args = (np.asarray(x0), np.asarray(x1))
+        if out is not None:
+            shape = np.broadcast_shapes(*(x.shape for x in args))
+            _check_out_array(out, shape, self.control_points.dtype)
+            self._impl(*args, out=out, num_threads=num_threads)
+            return out  # type: ignore[return-value]
+        return self._impl(*args, num_threads=num_threads)
@@ -1,11 +1,14 @@
-from typing import TypeVar
+from collections.abc import Sequence
+from typing import Optional, TypeVar
 
 import numpy as np
 from numpy.typing import ArrayLike
 
 from . import _lib
-from ._cubic_b_spline import CubicBSpline
+from ._cubic_b_spline import _check_out_array
+from ._cubic_b_spline_2d import BiCubicBSpline
 from ._cubic_b_spline_basis import CubicBSplineBasis
+from ._spline_file import PathLike, _load_impl
 
 __all__ = [
     "TriCubicBSpline",
@@ -48,36 +51,52 @@ class TriCubicBSpline:
         basis1 = CubicBSplineBasis(knots[1])
         basis2 = CubicBSplineBasis(knots[2])
 
-        knots0 = basis0.knots
-        knots1 = basis1.knots
-        knots2 = basis2.knots
         values = np.asanyarray(values)
+        dtype = np.common_type(values)
 
-        m = len(knots0)
-        n = len(knots1)
-        p = len(knots2)
+        # Fit each axis in turn. Each pass solves a batch of 1-D interpolation problems
+        # along one axis of the output of the previous pass.
+        tmp = basis2.interpolate_control_points(values, axis=2)
+        tmp = basis1.interpolate_control_points(tmp, axis=1)
+        control_points = basis0.interpolate_control_points(tmp, axis=0)
+        control_points = control_points.astype(dtype, copy=False)
 
-        dtype = np.common_type(values)
+        return cls((basis0, basis1, basis2), control_points)
 
-        tmp1 = np.zeros_like(values, dtype=dtype, shape=(m, n, p + 2))
-        for i in range(m):
-            for j in range(n):
-                spline = CubicBSpline.interpolate(knots2, values[i, j, :])
-                tmp1[i, j, :] = spline.control_points
+    @classmethod
+    def load(cls: type[TriCubicBSplineT], path: PathLike) -> TriCubicBSplineT:
+        """
+        Load a spline from a file written by `TriCubicBSpline.save`.
+
+        Parameters
+        ----------
+        path : str or os.PathLike
+            The path of the input file.
+
+        Returns
+        -------
+        TriCubicBSpline
+            The loaded spline.
+        """
+        obj = cls.__new__(cls)
+        obj._impl = _load_impl(
+            path, _lib.TriCubicBSpline__f32, _lib.TriCubicBSpline__f64
+        )
+        return obj
 
-        tmp2 = np.zeros_like(tmp1, shape=(m, n + 2, p + 2))
-        for i in range(m):
-            for k in range(p + 2):
-                spline = CubicBSpline.interpolate(knots1, tmp1[i, :, k])
-                tmp2[i, :, k] = spline.control_points
+    def save(self, path: PathLike) -> None:
+        """
+        Save the spline to a file.
 
-        control_points = np.zeros_like(tmp2, shape=(m + 2, n + 2, p + 2))
-        for j in range(n + 2):
-            for k in range(p + 2):
-                spline = CubicBSpline.interpolate(knots0, tmp2[:, j, k])
-                control_points[:, j, k] = spline.control_points
+        The file stores the knots and control points as raw binary arrays. It can be
+        read back with `TriCubicBSpline.load`.
 
-        return cls((basis0, basis1, basis2), control_points)
+        Parameters
+        ----------
+        path : str or os.PathLike
+            The path of the output file. An existing file is overwritten.
+        """
+        self._impl.save(path)
 
     @property
     def knots(self) -> tuple[np.ndarray, np.ndarray, np.ndarray]:
@@ -89,6 +108,121 @@ class TriCubicBSpline:
         """ """
         return self._impl.control_points
 
-    def __call__(self, x0: float, x1: float, x2: float) -> float:
+    def slice(self, axis: int, x: float) -> BiCubicBSpline:
+        """
+        Restrict the spline to a plane of constant coordinate along one axis.
+
+        Contracts the control points along `axis` with the basis function weights at
+        `x`, producing a `BiCubicBSpline` over the two remaining axes that is equal to
+        this spline wherever the coordinate along `axis` is `x`. Evaluating the result
+        requires 16 rather than 64 control point multiply-adds per point.
+
+        Parameters
+        ----------
+        axis : int
+            The axis to contract. Must be 0, 1, or 2 (or the equivalent negative index).
+        x : float
+            The coordinate along `axis`. Must be within the range of the knots along
+            `axis`, inclusive.
+
+        Returns
+        -------
+        BiCubicBSpline
+            The 2-D spline over the remaining axes, in their original order.
+        """
+        axis = range(3)[axis]
+        bases = tuple(
+            CubicBSplineBasis(knots) for i, knots in enumerate(self.knots) if i != axis
+        )
+        control_points = self._impl.slice_control_points(axis, x)
+        return BiCubicBSpline(bases, control_points)  # type: ignore[arg-type]
+
+    def evaluate(
+        self,
+        x0: ArrayLike,
+        x1: ArrayLike,
+        x2: ArrayLike,
+        derivatives: Sequence[tuple[int, int, int]] = (
+            (0, 0, 0),
+            (1, 0, 0),
+            (0, 1, 0),
+            (0, 0, 1),
+        ),
+        *,
+        out: Optional[np.ndarray] = None,
+        num_threads: int = 0,
+    ) -> np.ndarray:
+        """
+        Evaluate the spline and its derivatives at a batch of points.
+
+        All requested derivatives are computed together in a single pass over the
+        control points surrounding each point, which is faster than evaluating them
+        separately. The Python GIL is released during evaluation.
+
+        Parameters
+        ----------
+        x0 : array_like
+            The coordinates of the points along axis 0.
+        x1 : array_like
+            The coordinates of the points along axis 1.
+        x2 : array_like
+            The coordinates of the points along axis 2. The coordinates along each axis
+            are broadcast against each other.
+        derivatives : sequence of tuple of int, optional
+            The derivatives to evaluate. Each element is a 3-tuple containing the
+            order of the partial derivative along each axis, where all zeros denotes the
+            value of the spline. Orders up to 2 along each axis are supported. Defaults
+            to the value and gradient.
+        out : numpy.ndarray or None, optional
+            A C-contiguous array to store the results in. It must have the shape of the
+            result and the same data type as the spline, or float32. If None, a new
+            array is allocated. Defaults to None.
+        num_threads : int, optional
+            The number of worker threads to use. If zero, the number of concurrent
+            threads supported by the hardware is used. Defaults to 0.
+
+        Returns
+        -------
+        numpy.ndarray
+            The results, stacked along the first axis in the order given by
+            `derivatives`. The remaining axes have the broadcast shape of the input
+            coordinates. If `out` was provided, it is returned.
+        """
+        derivatives = [tuple(int(order) for order in orders) for orders in derivatives]
+        if any(len(orders) != 3 for orders in derivatives):
+            raise ValueError("each element of derivatives must have length 3")
+        if any(order < 0 or order > 2 for orders in derivatives for order in orders):
+            raise ValueError("derivative orders must be in the range [0, 2]")
+        args = (np.asarray(x0), np.asarray(x1), np.asarray(x2))
+        if out is not None:
+            shape = (len(derivatives), *np.broadcast_shapes(*(x.shape for x in args)))
+            _check_out_array(out, shape, self.control_points.dtype)
+            self._impl.evaluate(
+                *args, derivatives=derivatives, out=out, num_threads=num_threads
+            )
+            return out
+        return self._impl.evaluate(
+            *args, derivatives=derivatives, num_threads=num_threads
+        )
+
+    def __call__(
+        self,
+        x0: float,
+        x1: float,
+        x2: float,
+        *,
+        out: Optional[np.ndarray] = None,
+        num_threads: int = 0,
+    ) -> float:
         """ """
-        return self._impl(x0, x1, x2)
+        if out is None and np.ndim(x0) == 0 and np.ndim(x1) == 0 and np.ndim(x2) == 0:
+            return self._impl(x0, x1, x2)
+
+        # Array arguments are broadcast against each other without being expanded.
+        args = (np.asarray(x0), np.asarray(x1), np.asarray(x2))
+        if out is not None:
+            shape = np.broadcast_shapes(*(x.shape for x in args))
+            _check_out_array(out, shape, self.control_points.dtype)
+            self._impl(*args, out=out, num_threads=num_threads)
+            return out  # type: ignore[return-value]
+        return self._impl(*args, num_threads=num_threads)
@@ -1,13 +1,19 @@
+from typing import TypeVar
+
 import numpy as np
 from numpy.typing import ArrayLike
 
 from . import _lib
+from ._spline_file import PathLike, _load_impl
 
 __all__ = [
     "CubicBSplineBasis",
 ]
 
 
+CubicBSplineBasisT = TypeVar("CubicBSplineBasisT", bound="CubicBSplineBasis")
+
+
 def _make_cubic_b_spline_basis_impl(knots):  # type: ignore[no-untyped-def]
     knots = np.ascontiguousarray(knots)
     if knots.dtype == np.float32:
@@ -20,6 +26,41 @@ class CubicBSplineBasis:
     def __init__(self, knots: ArrayLike):
         self._impl = _make_cubic_b_spline_basis_impl(knots)  # type: ignore[no-untyped-call]
 
+    @classmethod
+    def load(cls: type[CubicBSplineBasisT], path: PathLike) -> CubicBSplineBasisT:
+        """
+        Load a basis from a file written by `CubicBSplineBasis.save`.
+
+        Parameters
+        ----------
+        path : str or os.PathLike
+            The path of the input file.
+
+        Returns
+        -------
+        CubicBSplineBasis
+            The loaded basis.
+        """
+        obj = cls.__new__(cls)
+        obj._impl = _load_impl(
+            path, _lib.CubicBSplineBasis__f32, _lib.CubicBSplineBasis__f64
+        )
+        return obj
+
+    def save(self, path: PathLike) -> None:
+        """
+        Save the basis to a file.
+
+        The file stores the knots as raw binary arrays. It can be read back with
+        `CubicBSplineBasis.load`.
+
+        Parameters
+        ----------
+        path : str or os.PathLike
+            The path of the output file. An existing file is overwritten.
+        """
+        self._impl.save(path)
+
     @property
     def knots(self) -> np.ndarray:
         """ """
@@ -50,3 +91,36 @@ class CubicBSplineBasis:
     def eval_second_derivative_in_interval(self, x: float, i: int) -> float:
         """ """
         return self._impl.eval_second_derivative_in_interval(x, i)
+
+    def interpolate_control_points(
+        self, values: ArrayLike, axis: int = -1, *, num_threads: int = 0
+    ) -> np.ndarray:
+        """
+        Fit cubic B-spline control points to data sampled at the knots.
+
+        Each 1-D slice of `values` along `axis` is interpolated independently, subject
+        to the condition that the second derivative of the spline is zero at the first
+        and last knot. The basis matrix is factored once and reused for every slice, and
+        slices are solved in parallel with the Python GIL released.
+
+        Parameters
+        ----------
+        values : array_like
+            The data values. The length of `axis` must be equal to the number of knots.
+        axis : int, optional
+            The axis along which to interpolate. Defaults to -1.
+        num_threads : int, optional
+            The number of worker threads to use. If zero, the number of concurrent
+            threads supported by the hardware is used. Defaults to 0.
+
+        Returns
+        -------
+        numpy.ndarray
+            The control points. Has the same shape as `values` except that the length
+            of `axis` is two more than the number of knots.
+        """
+        values = np.ascontiguousarray(values, dtype=self.knots.dtype)
+        axis = range(values.ndim)[axis]
+        return self._impl.interpolate_control_points(
+            values, axis=axis, num_threads=num_threads
+        )
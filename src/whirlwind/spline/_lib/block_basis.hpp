@@ -0,0 +1,337 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
+
+namespace whirlwind::bindings {
+
+// The number of points evaluated together by the batch evaluation kernels.
+inline constexpr Size eval_block_size = 64;
+
+// The knot interval and basis function weights of a block of points, stored as a
+// structure of arrays so that the control point contractions can be vectorized across
+// points.
+//
+// `hint` is the knot interval of the last point evaluated. It is carried over between
+// consecutive blocks to seed the interval search for non-uniform knots.
+template<class T>
+struct BasisBlock {
+    std::array<Size, eval_block_size> interval;
+    std::array<std::array<T, eval_block_size>, 4> weights;
+    Size hint = 0;
+};
+
+// The highest order of basis function derivative that may be evaluated in batches.
+inline constexpr Size max_derivative_order = 2;
+
+// Like `BasisBlock`, but with the weights of each derivative of the basis functions up
+// to `max_derivative_order`. `weights[m]` holds the weights of the m-th derivative.
+template<class T>
+struct BasisDerivativeBlock {
+    using Weights = std::array<std::array<T, eval_block_size>, 4>;
+
+    std::array<Size, eval_block_size> interval;
+    std::array<Weights, max_derivative_order + 1> weights;
+    Size hint = 0;
+};
+
+// The weights of the four uniform cubic B-spline basis functions that are nonzero in a
+// knot interval, evaluated at the normalized position `t` within the interval.
+template<class T>
+[[nodiscard]] constexpr auto
+uniform_cubic_b_spline_weights(T t) noexcept -> std::array<T, 4>
+{
+    const auto s = T{1} - t;
+    const auto t2 = t * t;
+    const auto t3 = t2 * t;
+    return {s * s * s / T{6}, (T{3} * t3 - T{6} * t2 + T{4}) / T{6},
+            (T{-3} * t3 + T{3} * t2 + T{3} * t + T{1}) / T{6}, t3 / T{6}};
+}
+
+// The derivatives of `uniform_cubic_b_spline_weights()` with respect to `t`.
+template<class T>
+[[nodiscard]] constexpr auto
+uniform_cubic_b_spline_derivative_weights(T t) noexcept -> std::array<T, 4>
+{
+    const auto s = T{1} - t;
+    const auto t2 = t * t;
+    return {-s * s / T{2}, (T{3} * t2 - T{4} * t) / T{2},
+            (T{-3} * t2 + T{2} * t + T{1}) / T{2}, t2 / T{2}};
+}
+
+// The second derivatives of `uniform_cubic_b_spline_weights()` with respect to `t`.
+template<class T>
+[[nodiscard]] constexpr auto
+uniform_cubic_b_spline_second_derivative_weights(T t) noexcept -> std::array<T, 4>
+{
+    return {T{1} - t, T{3} * t - T{2}, T{-3} * t + T{1}, t};
+}
+
+// A cubic B-spline basis that evaluates blocks of points at once.
+//
+// If the knots are uniformly spaced, the knot interval of each point is computed
+// directly from its offset from the first knot, and the basis function weights are
+// computed in closed form, rather than by searching the knot vector and evaluating the
+// basis one point at a time. The closed-form weights are checked against the
+// underlying basis when the object is constructed, and unused if they disagree.
+//
+// Otherwise, the knot interval of each point is found by galloping search starting
+// from the interval of the previous point. For sorted or spatially coherent inputs
+// (e.g. raster scanlines), consecutive points usually fall in the same or an adjacent
+// interval, so this takes O(1) comparisons per point. For arbitrary inputs it is at
+// most about twice as expensive as a binary search.
+template<class Basis>
+class BlockBasis {
+public:
+    using knot_type = typename Basis::knot_type;
+
+    explicit BlockBasis(std::span<const knot_type> knots) : basis_(knots)
+    {
+        const auto k = basis_.knots();
+        const auto n = static_cast<Size>(k.size());
+        WHIRLWIND_ASSERT(n >= 2);
+
+        max_interval_ = n - 2;
+        origin_ = k[0];
+        spacing_ = (k[n - 1] - k[0]) / static_cast<knot_type>(n - 1);
+        is_uniform_ = (spacing_ > knot_type{0}) && has_uniform_knots(k) &&
+                      matches_closed_form(k);
+        inv_spacing_ = is_uniform_ ? knot_type{1} / spacing_ : knot_type{0};
+    }
+
+    [[nodiscard]] auto
+    is_uniform() const noexcept -> bool
+    {
+        return is_uniform_;
+    }
+
+    template<class Knot, class T>
+    void
+    eval_block(const Knot* x, Size count, BasisBlock<T>& out) const
+    {
+        WHIRLWIND_ASSERT(count <= eval_block_size);
+        if (is_uniform_) {
+            eval_block_uniform(x, count, out);
+        } else {
+            eval_block_generic(x, count, out);
+        }
+    }
+
+    // Evaluate the knot interval of each point along with the weights of the basis
+    // functions and their derivatives up to order `max_order`.
+    template<class Knot, class T>
+    void
+    eval_derivative_block(const Knot* x,
+                          Size count,
+                          Size max_order,
+                          BasisDerivativeBlock<T>& out) const
+    {
+        WHIRLWIND_ASSERT(count <= eval_block_size);
+        WHIRLWIND_ASSERT(max_order <= max_derivative_order);
+
+        auto hint = out.hint;
+        auto w = std::array<std::array<knot_type, 4>, max_derivative_order + 1>();
+        const auto assign = [&](Size m, const auto& weights) {
+            for (Size q = 0; q < 4; ++q) {
+                w[m][q] = weights[q];
+            }
+        };
+
+        for (Size k = 0; k < count; ++k) {
+            const auto xk = static_cast<knot_type>(x[k]);
+            Size i = 0;
+            if (is_uniform_) {
+                const auto u = (xk - origin_) * inv_spacing_;
+                const auto fi = get_uniform_interval(u);
+                const auto t = u - fi;
+                i = static_cast<Size>(fi);
+                assign(0, uniform_cubic_b_spline_weights(t));
+                if (max_order >= 1) {
+                    assign(1, uniform_cubic_b_spline_derivative_weights(t));
+                }
+                if (max_order >= 2) {
+                    assign(2, uniform_cubic_b_spline_second_derivative_weights(t));
+                }
+
+                // Convert derivatives with respect to `t` into derivatives with
+                // respect to `x`.
+                auto scale = knot_type{1};
+                for (Size m = 1; m <= max_order; ++m) {
+                    scale *= inv_spacing_;
+                    for (Size q = 0; q < 4; ++q) {
+                        w[m][q] *= scale;
+                    }
+                }
+            } else {
+                i = find_knot_interval(xk, hint);
+                hint = i;
+                assign(0, basis_.eval_in_interval(xk, i));
+                if (max_order >= 1) {
+                    assign(1, basis_.eval_derivative_in_interval(xk, i));
+                }
+                if (max_order >= 2) {
+                    assign(2, basis_.eval_second_derivative_in_interval(xk, i));
+                }
+            }
+
+            out.interval[k] = i;
+            for (Size m = 0; m <= max_order; ++m) {
+                for (Size q = 0; q < 4; ++q) {
+                    out.weights[m][q][k] = static_cast<T>(w[m][q]);
+                }
+            }
+        }
+        out.hint = hint;
+    }
+
+private:
+    // Get the (uniform) knot interval containing the point at normalized position `u`
+    // relative to the first knot. Points outside the knot range (and NaNs) are
+    // assigned to the nearest interval. Their weights are extrapolated from it.
+    [[nodiscard]] auto
+    get_uniform_interval(knot_type u) const noexcept -> knot_type
+    {
+        const auto max_interval = static_cast<knot_type>(max_interval_);
+        auto i = std::floor(u);
+        i = (i >= knot_type{0}) ? i : knot_type{0};
+        i = (i <= max_interval) ? i : max_interval;
+        return i;
+    }
+
+    [[nodiscard]] auto
+    has_uniform_knots(std::span<const knot_type> k) const -> bool
+    {
+        // Allow for the rounding error of e.g. `numpy.linspace()`.
+        constexpr auto eps = std::numeric_limits<knot_type>::epsilon();
+        const auto scale =
+                std::max({std::abs(k.front()), std::abs(k.back()), spacing_});
+        const auto tol = knot_type{16} * eps * scale;
+
+        for (Size i = 0; i < k.size(); ++i) {
+            const auto expected = origin_ + static_cast<knot_type>(i) * spacing_;
+            if (!(std::abs(k[i] - expected) <= tol)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] auto
+    matches_closed_form(std::span<const knot_type> k) const -> bool
+    {
+        const auto tol = std::sqrt(std::numeric_limits<knot_type>::epsilon());
+
+        // Compare against the underlying basis at a few positions within the first &
+        // last intervals.
+        for (const auto i : {Size{0}, max_interval_}) {
+            for (const auto t : {knot_type{0}, knot_type{0.25}, knot_type{0.75}}) {
+                const auto x = k[i] + t * spacing_;
+                const auto expected = basis_.eval_in_interval(x, i);
+                const auto actual = uniform_cubic_b_spline_weights(t);
+                const auto expected_d = basis_.eval_derivative_in_interval(x, i);
+                const auto actual_d = uniform_cubic_b_spline_derivative_weights(t);
+                for (Size q = 0; q < 4; ++q) {
+                    if (!(std::abs(actual[q] - expected[q]) <= tol)) {
+                        return false;
+                    }
+                    if (!(std::abs(actual_d[q] - expected_d[q] * spacing_) <= tol)) {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+    template<class Knot, class T>
+    void
+    eval_block_uniform(const Knot* x, Size count, BasisBlock<T>& out) const
+    {
+        for (Size k = 0; k < count; ++k) {
+            const auto u = (static_cast<knot_type>(x[k]) - origin_) * inv_spacing_;
+            const auto i = get_uniform_interval(u);
+            const auto w = uniform_cubic_b_spline_weights(u - i);
+            out.interval[k] = static_cast<Size>(i);
+            for (Size q = 0; q < 4; ++q) {
+                out.weights[q][k] = static_cast<T>(w[q]);
+            }
+        }
+    }
+
+    // Find the knot interval containing `x`, searching outward from interval `hint`.
+    // The result is the index `i` such that `knots[i] <= x < knots[i+1]`, clamped to
+    // the range of valid intervals.
+    [[nodiscard]] auto
+    find_knot_interval(knot_type x, Size hint) const -> Size
+    {
+        const auto k = basis_.knots();
+        const auto last = max_interval_;
+        const auto h = std::min(hint, last);
+
+        // Search for the interval within [lo, hi], where `knots[lo] <= x` (or lo == 0)
+        // and `x < knots[hi+1]` (or hi == last).
+        Size lo = 0;
+        Size hi = 0;
+        if (x >= k[h]) {
+            if (h == last || x < k[h + 1]) {
+                return h;
+            }
+            lo = h + 1;
+            auto bound = h + 2;
+            for (Size step = 2; bound <= last && k[bound] <= x; step *= 2) {
+                lo = bound;
+                bound += step;
+            }
+            hi = std::min(bound - 1, last);
+        } else {
+            if (h == 0) {
+                return 0;
+            }
+            hi = h - 1;
+            auto bound = h - 1;
+            for (Size step = 2; bound > 0 && x < k[bound]; step *= 2) {
+                hi = bound - 1;
+                bound = (bound > step) ? bound - step : 0;
+            }
+            lo = bound;
+        }
+
+        const auto first = k.begin() + static_cast<std::ptrdiff_t>(lo + 1);
+        const auto end = k.begin() + static_cast<std::ptrdiff_t>(hi + 1);
+        return static_cast<Size>(std::upper_bound(first, end, x) - k.begin()) - 1;
+    }
+
+    template<class Knot, class T>
+    void
+    eval_block_generic(const Knot* x, Size count, BasisBlock<T>& out) const
+    {
+        auto hint = out.hint;
+        for (Size k = 0; k < count; ++k) {
+            const auto xk = static_cast<knot_type>(x[k]);
+            const auto i = find_knot_interval(xk, hint);
+            const auto w = basis_.eval_in_interval(xk, i);
+            out.interval[k] = i;
+            for (Size q = 0; q < 4; ++q) {
+                out.weights[q][k] = static_cast<T>(w[q]);
+            }
+            hint = i;
+        }
+        out.hint = hint;
+    }
+
+    Basis basis_;
+    Size max_interval_;
+    knot_type origin_;
+    knot_type spacing_;
+    knot_type inv_spacing_;
+    bool is_uniform_;
+};
+
+} // namespace whirlwind::bindings
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nanobind/ndarray.h>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
+
+namespace whirlwind::bindings {
+
+namespace nb = nanobind;
+
+template<class T>
+using PyStridedArray = nb::ndarray<T, nb::device::cpu>;
+
+// A read-only view of an array broadcast to a (possibly larger) shape, without copying.
+// Broadcast axes have a stride of zero.
+template<class T>
+class BroadcastView {
+public:
+    BroadcastView(const T* data,
+                  std::vector<std::size_t> shape,
+                  std::vector<std::ptrdiff_t> strides)
+        : data_(data), shape_(std::move(shape)), strides_(std::move(strides))
+    {
+        WHIRLWIND_ASSERT(shape_.size() == strides_.size());
+
+        is_constant_ = std::all_of(strides_.begin(), strides_.end(),
+                                   [](auto stride) { return stride == 0; });
+
+        // Check whether the elements are stored contiguously in row-major order.
+        is_contiguous_ = true;
+        std::ptrdiff_t expected_stride = 1;
+        for (auto d = shape_.size(); d-- > 0;) {
+            if (shape_[d] != 1 && strides_[d] != expected_stride) {
+                is_contiguous_ = false;
+            }
+            expected_stride *= static_cast<std::ptrdiff_t>(shape_[d]);
+        }
+    }
+
+    // Get the elements in the range [begin, begin + count) in row-major order as a
+    // contiguous sequence. Returns a pointer to the underlying data if it is already
+    // contiguous; otherwise, the elements are gathered into `buffer`.
+    [[nodiscard]] auto
+    get(Size begin, Size count, T* buffer) const -> const T*
+    {
+        if (is_contiguous_) {
+            return data_ + begin;
+        }
+        if (is_constant_) {
+            std::fill_n(buffer, count, *data_);
+            return buffer;
+        }
+
+        // Copy contiguous runs along the last axis. The starting offset of each run is
+        // found by unraveling its flat index.
+        const auto ndim = shape_.size();
+        const auto last_extent = static_cast<Size>(shape_[ndim - 1]);
+        const auto last_stride = strides_[ndim - 1];
+
+        Size k = 0;
+        while (k < count) {
+            auto index = begin + k;
+            const auto pos = index % last_extent;
+            std::ptrdiff_t offset = 0;
+            for (auto d = ndim; d-- > 0;) {
+                const auto extent = static_cast<Size>(shape_[d]);
+                offset += static_cast<std::ptrdiff_t>(index % extent) * strides_[d];
+                index /= extent;
+            }
+
+            const auto run = std::min(count - k, last_extent - pos);
+            const auto* src = data_ + offset;
+            for (Size r = 0; r < run; ++r) {
+                buffer[k + r] = src[static_cast<std::ptrdiff_t>(r) * last_stride];
+            }
+            k += run;
+        }
+        return buffer;
+    }
+
+private:
+    const T* data_;
+    std::vector<std::size_t> shape_;
+    std::vector<std::ptrdiff_t> strides_;
+    bool is_constant_;
+    bool is_contiguous_;
+};
+
+// Get the shape of the result of broadcasting arrays with the specified shapes
+// together, following NumPy's broadcasting rules. Throws `std::invalid_argument` if
+// the shapes are incompatible.
+[[nodiscard]] inline auto
+broadcast_shapes(const std::vector<std::vector<std::size_t>>& shapes)
+        -> std::vector<std::size_t>
+{
+    std::size_t ndim = 0;
+    for (const auto& shape : shapes) {
+        ndim = std::max(ndim, shape.size());
+    }
+
+    auto out = std::vector<std::size_t>(ndim, 1);
+    for (const auto& shape : shapes) {
+        const auto offset = ndim - shape.size();
+        for (std::size_t d = 0; d < shape.size(); ++d) {
+            auto& extent = out[offset + d];
+            if (extent == 1) {
+                extent = shape[d];
+            } else if (shape[d] != 1 && shape[d] != extent) {
+                throw std::invalid_argument(
+                        "shape mismatch: coordinates cannot be broadcast to a single "
+                        "shape");
+            }
+        }
+    }
+    return out;
+}
+
+// Get the total number of elements in an array with the specified shape.
+[[nodiscard]] inline auto
+num_elements(const std::vector<std::size_t>& shape) -> Size
+{
+    Size size = 1;
+    for (const auto& extent : shape) {
+        size *= static_cast<Size>(extent);
+    }
+    return size;
+}
+
+// Make a view of a NumPy-compatible array broadcast to the specified shape.
+template<class T, class... Args>
+[[nodiscard]] auto
+make_broadcast_view(const nb::ndarray<T, Args...>& arr,
+                    const std::vector<std::size_t>& shape)
+        -> BroadcastView<std::remove_const_t<T>>
+{
+    const std::size_t ndim = arr.ndim();
+    WHIRLWIND_ASSERT(ndim <= shape.size());
+
+    const auto offset = shape.size() - ndim;
+    auto strides = std::vector<std::ptrdiff_t>(shape.size(), 0);
+    for (std::size_t d = 0; d < ndim; ++d) {
+        if (arr.shape(d) != 1) {
+            WHIRLWIND_ASSERT(arr.shape(d) == shape[offset + d]);
+            strides[offset + d] = static_cast<std::ptrdiff_t>(arr.stride(d));
+        }
+    }
+    return BroadcastView<std::remove_const_t<T>>(arr.data(), shape, std::move(strides));
+}
+
+} // namespace whirlwind::bindings
@@ -1,18 +1,85 @@
+#include <array>
+#include <filesystem>
 #include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <nanobind/nanobind.h>
+#include <nanobind/stl/filesystem.h>
+#include <nanobind/stl/vector.h>
 
 #include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
 #include <whirlwind/spline/cubic_b_spline.hpp>
 #include <whirlwind/spline/cubic_b_spline_basis.hpp>
 
 #include "array.hpp"
+#include "broadcast.hpp"
+#include "evaluate.hpp"
+#include "spline_file.hpp"
 
 namespace whirlwind::bindings {
 
 namespace nb = nanobind;
 using namespace nb::literals;
 
+// Convert the orders of the derivatives of a 1-D spline to the form expected by
+// `eval_spline_derivatives()`.
+[[nodiscard]] inline auto
+get_derivative_orders(const std::vector<Size>& derivatives)
+        -> std::vector<std::array<Size, 1>>
+{
+    auto orders = std::vector<std::array<Size, 1>>();
+    orders.reserve(derivatives.size());
+    for (const auto& order : derivatives) {
+        orders.push_back({order});
+    }
+    return orders;
+}
+
+// Add overloads of the batch evaluation methods that write the results to an existing
+// array with elements of type `Out`.
+template<class Out, class Class>
+void
+cubic_b_spline_out_methods(nb::class_<Class>& cls)
+{
+    using Knot = typename Class::knot_type;
+
+    cls.def(
+            "evaluate",
+            [](const Class& self, const PyStridedArray<const Knot>& x,
+               const std::vector<Size>& derivatives, PyContiguousArray<Out> out,
+               Size num_threads) {
+                const auto shape = shape_of(x);
+                const auto x_views = std::array{make_broadcast_view(x, shape)};
+                const auto size = num_elements(shape);
+                const auto orders = get_derivative_orders(derivatives);
+
+                auto out_shape = shape;
+                out_shape.insert(out_shape.begin(), orders.size());
+                WHIRLWIND_ASSERT(shape_of(out) == out_shape);
+
+                [[maybe_unused]] const nb::gil_scoped_release nogil;
+                eval_spline_derivatives_into<1>(self, x_views, size, std::span(orders),
+                                                out.data(), num_threads);
+            },
+            "x"_a, "derivatives"_a, "out"_a.noconvert(), "num_threads"_a = 0);
+    cls.def(
+            "__call__",
+            [](const Class& self, const PyStridedArray<const Knot>& x,
+               PyContiguousArray<Out> out, Size num_threads) {
+                const auto shape = shape_of(x);
+                const auto x_view = make_broadcast_view(x, shape);
+                const auto size = num_elements(shape);
+                WHIRLWIND_ASSERT(shape_of(out) == shape);
+
+                [[maybe_unused]] const nb::gil_scoped_release nogil;
+                eval_spline_into(self, x_view, size, out.data(), num_threads);
+            },
+            "x"_a, "out"_a.noconvert(), "num_threads"_a = 0);
+}
+
 template<class Class>
 void
 cubic_b_spline_attrs_and_methods(nb::class_<Class>& cls)
@@ -21,6 +88,9 @@ cubic_b_spline_attrs_and_methods(nb::class_<Class>& cls)
     using Value = typename Class::value_type;
     using Basis = typename Class::basis_type;
 
+    // Spline files store the knots & control points with a single element type.
+    static_assert(std::is_same_v<Knot, Value>);
+
     // Constructors.
     cls.def(
             "__init__",
@@ -32,6 +102,28 @@ cubic_b_spline_attrs_and_methods(nb::class_<Class>& cls)
             },
             "basis"_a, "control_points"_a);
 
+    // Serialization.
+    cls.def(
+            "save",
+            [](const Class& self, const std::filesystem::path& path) {
+                const auto knots = std::array{self.knots()};
+                const auto& control_points = self.control_points();
+                WHIRLWIND_ASSERT(is_contiguous_range(control_points.container()));
+                save_spline_file<Value>(
+                        path, knots,
+                        std::span(control_points.data(), control_points.size()));
+            },
+            "path"_a, nb::call_guard<nb::gil_scoped_release>());
+    cls.def_static(
+            "load",
+            [](const std::filesystem::path& path) {
+                [[maybe_unused]] const nb::gil_scoped_release nogil;
+                const auto contents = load_spline_file<Value>(path, 1, true);
+                return Class(Basis(std::span(contents.knots[0])),
+                             std::span(contents.control_points));
+            },
+            "path"_a);
+
     // Static attributes.
     cls.def_prop_ro_static("num_dims", [](nb::handle) { return Class::num_dims(); });
 
@@ -54,24 +146,56 @@ cubic_b_spline_attrs_and_methods(nb::class_<Class>& cls)
             },
             nb::rv_policy::reference_internal);
 
+    // Methods.
+    cls.def(
+            "evaluate",
+            [](const Class& self, const PyStridedArray<const Knot>& x,
+               const std::vector<Size>& derivatives, Size num_threads) {
+                const auto shape = shape_of(x);
+                const auto x_views = std::array{make_broadcast_view(x, shape)};
+                const auto size = num_elements(shape);
+
+                const auto orders = get_derivative_orders(derivatives);
+
+                auto y = [&]() {
+                    [[maybe_unused]] const nb::gil_scoped_release nogil;
+                    return eval_spline_derivatives<1>(self, x_views, size,
+                                                      std::span(orders), num_threads);
+                }();
+
+                auto out_shape = shape;
+                out_shape.insert(out_shape.begin(), orders.size());
+                return to_numpy_array(std::move(y), out_shape);
+            },
+            "x"_a, "derivatives"_a, "num_threads"_a = 0);
+
     // Dunder methods.
     cls.def(
             "__call__", [](const Class& self, const Knot& x) { return self(x); }, "x"_a,
             nb::call_guard<nb::gil_scoped_release>());
     cls.def(
             "__call__",
-            [](const Class& self, const PyContiguousArray<const Knot>& x) {
-                const auto x_span = std::span(x.data(), x.size());
+            [](const Class& self, const PyStridedArray<const Knot>& x,
+               Size num_threads) {
+                const auto shape = shape_of(x);
+                const auto x_view = make_broadcast_view(x, shape);
+                const auto size = num_elements(shape);
 
                 auto y = [&]() {
                     [[maybe_unused]] const nb::gil_scoped_release nogil;
-                    return self(x_span);
+                    return eval_spline(self, x_view, size, num_threads);
                 }();
 
-                const auto shape = shape_of(x);
                 return to_numpy_array(std::move(y), shape);
             },
-            "x"_a);
+            "x"_a, "num_threads"_a = 0);
+
+    // Overloads that write to an existing array. Splines with double precision control
+    // points may also write single precision results.
+    cubic_b_spline_out_methods<Value>(cls);
+    if constexpr (!std::is_same_v<Value, float>) {
+        cubic_b_spline_out_methods<float>(cls);
+    }
 }
 
 template<class T>
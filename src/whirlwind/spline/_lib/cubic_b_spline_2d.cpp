@@ -1,20 +1,77 @@
+#include <array>
+#include <filesystem>
 #include <span>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <nanobind/nanobind.h>
+#include <nanobind/stl/array.h>
+#include <nanobind/stl/filesystem.h>
 #include <nanobind/stl/pair.h>
+#include <nanobind/stl/vector.h>
 
 #include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
 #include <whirlwind/spline/cubic_b_spline_2d.hpp>
 #include <whirlwind/spline/cubic_b_spline_basis.hpp>
 
 #include "array.hpp"
+#include "broadcast.hpp"
+#include "evaluate.hpp"
+#include "spline_file.hpp"
 
 namespace whirlwind::bindings {
 
 namespace nb = nanobind;
 using namespace nb::literals;
 
+// Add overloads of the batch evaluation methods that write the results to an existing
+// array with elements of type `Out`.
+template<class Out, class Class>
+void
+bi_cubic_b_spline_out_methods(nb::class_<Class>& cls)
+{
+    using Knot = typename Class::knot_type;
+
+    cls.def(
+            "evaluate",
+            [](const Class& self, const PyStridedArray<const Knot>& x0,
+               const PyStridedArray<const Knot>& x1,
+               const std::vector<std::array<Size, 2>>& derivatives,
+               PyContiguousArray<Out> out, Size num_threads) {
+                const auto shape = broadcast_shapes({shape_of(x0), shape_of(x1)});
+                const auto x_views = std::array{make_broadcast_view(x0, shape),
+                                                make_broadcast_view(x1, shape)};
+                const auto size = num_elements(shape);
+
+                auto out_shape = shape;
+                out_shape.insert(out_shape.begin(), derivatives.size());
+                WHIRLWIND_ASSERT(shape_of(out) == out_shape);
+
+                [[maybe_unused]] const nb::gil_scoped_release nogil;
+                eval_spline_derivatives_into<2>(self, x_views, size,
+                                                std::span(derivatives), out.data(),
+                                                num_threads);
+            },
+            "x0"_a, "x1"_a, "derivatives"_a, "out"_a.noconvert(), "num_threads"_a = 0);
+    cls.def(
+            "__call__",
+            [](const Class& self, const PyStridedArray<const Knot>& x0,
+               const PyStridedArray<const Knot>& x1,
+               PyContiguousArray<Out> out, Size num_threads) {
+                const auto shape = broadcast_shapes({shape_of(x0), shape_of(x1)});
+                const auto x0_view = make_broadcast_view(x0, shape);
+                const auto x1_view = make_broadcast_view(x1, shape);
+                const auto size = num_elements(shape);
+                WHIRLWIND_ASSERT(shape_of(out) == shape);
+
+                [[maybe_unused]] const nb::gil_scoped_release nogil;
+                eval_spline_into(self, x0_view, x1_view, size, out.data(), num_threads);
+            },
+            "x0"_a, "x1"_a, "out"_a.noconvert(), "num_threads"_a = 0);
+}
+
 template<class Class>
 void
 bi_cubic_b_spline_attrs_and_methods(nb::class_<Class>& cls)
@@ -23,6 +80,9 @@ bi_cubic_b_spline_attrs_and_methods(nb::class_<Class>& cls)
     using Value = typename Class::value_type;
     using Basis = typename Class::basis_type;
 
+    // Spline files store the knots & control points with a single element type.
+    static_assert(std::is_same_v<Knot, Value>);
+
     // Constructors.
     cls.def(
             "__init__",
@@ -43,6 +103,29 @@ bi_cubic_b_spline_attrs_and_methods(nb::class_<Class>& cls)
             },
             "basis0"_a, "basis1"_a, "control_points"_a);
 
+    // Serialization.
+    cls.def(
+            "save",
+            [](const Class& self, const std::filesystem::path& path) {
+                const auto knots = std::array{self.knots(0), self.knots(1)};
+                const auto& control_points = self.control_points();
+                WHIRLWIND_ASSERT(is_contiguous_range(control_points.container()));
+                save_spline_file<Value>(
+                        path, knots,
+                        std::span(control_points.data(), control_points.size()));
+            },
+            "path"_a, nb::call_guard<nb::gil_scoped_release>());
+    cls.def_static(
+            "load",
+            [](const std::filesystem::path& path) {
+                [[maybe_unused]] const nb::gil_scoped_release nogil;
+                const auto contents = load_spline_file<Value>(path, 2, true);
+                return Class(Basis(std::span(contents.knots[0])),
+                             Basis(std::span(contents.knots[1])),
+                             std::span(contents.control_points));
+            },
+            "path"_a);
+
     // Static attributes.
     cls.def_prop_ro_static("num_dims", [](nb::handle) { return Class::num_dims(); });
 
@@ -73,6 +156,30 @@ bi_cubic_b_spline_attrs_and_methods(nb::class_<Class>& cls)
             },
             nb::rv_policy::reference_internal);
 
+    // Methods.
+    cls.def(
+            "evaluate",
+            [](const Class& self, const PyStridedArray<const Knot>& x0,
+               const PyStridedArray<const Knot>& x1,
+               const std::vector<std::array<Size, 2>>& derivatives, Size num_threads) {
+                const auto shape = broadcast_shapes({shape_of(x0), shape_of(x1)});
+                const auto x_views = std::array{make_broadcast_view(x0, shape),
+                                                make_broadcast_view(x1, shape)};
+                const auto size = num_elements(shape);
+
+                auto y = [&]() {
+                    [[maybe_unused]] const nb::gil_scoped_release nogil;
+                    return eval_spline_derivatives<2>(self, x_views, size,
+                                                      std::span(derivatives),
+                                                      num_threads);
+                }();
+
+                auto out_shape = shape;
+                out_shape.insert(out_shape.begin(), derivatives.size());
+                return to_numpy_array(std::move(y), out_shape);
+            },
+            "x0"_a, "x1"_a, "derivatives"_a, "num_threads"_a = 0);
+
     // Dunder methods.
     cls.def(
             "__call__",
@@ -82,22 +189,28 @@ bi_cubic_b_spline_attrs_and_methods(nb::class_<Class>& cls)
             "x0"_a, "x1"_a, nb::call_guard<nb::gil_scoped_release>());
     cls.def(
             "__call__",
-            [](const Class& self, const PyContiguousArray<const Knot>& x0,
-               const PyContiguousArray<const Knot>& x1) {
-                const auto shape = shape_of(x0);
-                WHIRLWIND_ASSERT(shape_of(x1) == shape);
-
-                const auto x0_span = std::span(x0.data(), x0.size());
-                const auto x1_span = std::span(x1.data(), x1.size());
+            [](const Class& self, const PyStridedArray<const Knot>& x0,
+               const PyStridedArray<const Knot>& x1, Size num_threads) {
+                const auto shape = broadcast_shapes({shape_of(x0), shape_of(x1)});
+                const auto x0_view = make_broadcast_view(x0, shape);
+                const auto x1_view = make_broadcast_view(x1, shape);
+                const auto size = num_elements(shape);
 
                 auto y = [&]() {
                     [[maybe_unused]] const nb::gil_scoped_release nogil;
-                    return self(x0_span, x1_span);
+                    return eval_spline(self, x0_view, x1_view, size, num_threads);
                 }();
 
                 return to_numpy_array(std::move(y), shape);
             },
-            "x0"_a, "x1"_a);
+            "x0"_a, "x1"_a, "num_threads"_a = 0);
+
+    // Overloads that write to an existing array. Splines with double precision control
+    // points may also write single precision results.
+    bi_cubic_b_spline_out_methods<Value>(cls);
+    if constexpr (!std::is_same_v<Value, float>) {
+        bi_cubic_b_spline_out_methods<float>(cls);
+    }
 }
 
 template<class T>
@@ -1,11 +1,20 @@
+#include <array>
+#include <cstddef>
+#include <filesystem>
 #include <span>
+#include <utility>
 
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/array.h>
+#include <nanobind/stl/filesystem.h>
 
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
 #include <whirlwind/spline/cubic_b_spline_basis.hpp>
 
 #include "array.hpp"
+#include "interpolate.hpp"
+#include "spline_file.hpp"
 
 namespace whirlwind::bindings {
 
@@ -27,6 +36,23 @@ cubic_b_spline_basis_attrs_and_methods(nb::class_<Class>& cls)
             },
             "knots"_a, nb::call_guard<nb::gil_scoped_release>());
 
+    // Serialization.
+    cls.def(
+            "save",
+            [](const Class& self, const std::filesystem::path& path) {
+                const auto knots = std::array{self.knots()};
+                save_spline_file<Knot>(path, knots);
+            },
+            "path"_a, nb::call_guard<nb::gil_scoped_release>());
+    cls.def_static(
+            "load",
+            [](const std::filesystem::path& path) {
+                [[maybe_unused]] const nb::gil_scoped_release nogil;
+                const auto contents = load_spline_file<Knot>(path, 1, false);
+                return Class(std::span(contents.knots[0]));
+            },
+            "path"_a);
+
     // Attributes.
     cls.def_prop_ro(
             "knots",
@@ -46,6 +72,35 @@ cubic_b_spline_basis_attrs_and_methods(nb::class_<Class>& cls)
             "i"_a);
     cls.def("eval_second_derivative_in_interval",
             &Class::eval_second_derivative_in_interval, "x"_a, "i"_a);
+    cls.def(
+            "interpolate_control_points",
+            [](const Class& self, const PyContiguousArray<const Knot>& values,
+               std::size_t axis, Size num_threads) {
+                auto shape = shape_of(values);
+                WHIRLWIND_ASSERT(axis < shape.size());
+                WHIRLWIND_ASSERT(shape[axis] == self.knots().size());
+
+                Size outer = 1;
+                for (std::size_t i = 0; i < axis; ++i) {
+                    outer *= shape[i];
+                }
+                Size inner = 1;
+                for (std::size_t i = axis + 1; i < shape.size(); ++i) {
+                    inner *= shape[i];
+                }
+
+                const auto values_span = std::span(values.data(), values.size());
+
+                auto control_points = [&]() {
+                    [[maybe_unused]] const nb::gil_scoped_release nogil;
+                    return interpolate_control_points(self, values_span, outer, inner,
+                                                      num_threads);
+                }();
+
+                shape[axis] += 2;
+                return to_numpy_array(std::move(control_points), shape);
+            },
+            "values"_a, "axis"_a, "num_threads"_a = 0);
 }
 
 template<class Knot>
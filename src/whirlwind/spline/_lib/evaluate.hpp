@@ -0,0 +1,526 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
+
+#include "block_basis.hpp"
+#include "broadcast.hpp"
+#include "parallel.hpp"
+
+namespace whirlwind::bindings {
+
+// A block of results, accumulated in the precision of the spline.
+template<class Value>
+using ResultBlock = std::array<Value, eval_block_size>;
+
+// Store the first `count` results of a block to `out`, converting them to the output
+// type.
+template<class Value, class Out>
+void
+store_block(const ResultBlock<Value>& acc, Size count, Out* out)
+{
+    for (Size k = 0; k < count; ++k) {
+        out[k] = static_cast<Out>(acc[k]);
+    }
+}
+
+// Evaluate a 1-D cubic B-spline at the points in the range [begin, end). The result
+// for the k-th point is written to `y[k]`.
+//
+// Points are processed in blocks: the basis weights for the whole block are computed
+// first, followed by the 4-term contraction with the control points. Each step loops
+// over the points in the block innermost, which lets the compiler vectorize them. The
+// input coordinates may be strided or broadcast; each block of coordinates is gathered
+// into a contiguous buffer if needed. The results are accumulated in the precision of
+// the control points, and may be stored with lower precision.
+template<class Basis, class Knot, class Value, class Out>
+void
+eval_cubic_b_spline(const BlockBasis<Basis>& basis,
+                    const Value* control_points,
+                    const BroadcastView<Knot>& x,
+                    Size begin,
+                    Size end,
+                    Out* y)
+{
+    auto buffer = std::array<Knot, eval_block_size>();
+    auto b = BasisBlock<Value>();
+    auto acc = ResultBlock<Value>();
+
+    for (Size first = begin; first < end; first += eval_block_size) {
+        const auto count = std::min(eval_block_size, end - first);
+        basis.eval_block(x.get(first, count, buffer.data()), count, b);
+
+        for (Size k = 0; k < count; ++k) {
+            acc[k] = Value{0};
+        }
+        for (Size q = 0; q < 4; ++q) {
+            for (Size k = 0; k < count; ++k) {
+                acc[k] += b.weights[q][k] * control_points[b.interval[k] + q];
+            }
+        }
+        store_block(acc, count, y + first);
+    }
+}
+
+// Evaluate a 2-D tensor-product cubic B-spline at the points in the range
+// [begin, end). The control points are stored in row-major order with `stride0`
+// elements per row.
+template<class Basis, class Knot, class Value, class Out>
+void
+eval_bi_cubic_b_spline(const BlockBasis<Basis>& basis0,
+                       const BlockBasis<Basis>& basis1,
+                       const Value* control_points,
+                       Size stride0,
+                       const BroadcastView<Knot>& x0,
+                       const BroadcastView<Knot>& x1,
+                       Size begin,
+                       Size end,
+                       Out* y)
+{
+    auto buffer0 = std::array<Knot, eval_block_size>();
+    auto buffer1 = std::array<Knot, eval_block_size>();
+    auto b0 = BasisBlock<Value>();
+    auto b1 = BasisBlock<Value>();
+    auto offset = std::array<Size, eval_block_size>();
+    auto acc = ResultBlock<Value>();
+
+    for (Size first = begin; first < end; first += eval_block_size) {
+        const auto count = std::min(eval_block_size, end - first);
+        basis0.eval_block(x0.get(first, count, buffer0.data()), count, b0);
+        basis1.eval_block(x1.get(first, count, buffer1.data()), count, b1);
+
+        for (Size k = 0; k < count; ++k) {
+            offset[k] = b0.interval[k] * stride0 + b1.interval[k];
+            acc[k] = Value{0};
+        }
+
+        for (Size i = 0; i < 4; ++i) {
+            for (Size j = 0; j < 4; ++j) {
+                const auto* c = control_points + i * stride0 + j;
+                for (Size k = 0; k < count; ++k) {
+                    acc[k] += b0.weights[i][k] * b1.weights[j][k] * c[offset[k]];
+                }
+            }
+        }
+        store_block(acc, count, y + first);
+    }
+}
+
+// Evaluate a 3-D tensor-product cubic B-spline at the points in the range
+// [begin, end). The control points are stored in row-major order, where `stride0` &
+// `stride1` are the number of elements between consecutive indices along the first
+// and second axes, respectively.
+//
+// The innermost 4-term contraction along the last (contiguous) axis is performed first
+// for each (i,j) pair, so that each point reads 16 runs of 4 adjacent control points.
+template<class Basis, class Knot, class Value, class Out>
+void
+eval_tri_cubic_b_spline(const BlockBasis<Basis>& basis0,
+                        const BlockBasis<Basis>& basis1,
+                        const BlockBasis<Basis>& basis2,
+                        const Value* control_points,
+                        Size stride0,
+                        Size stride1,
+                        const BroadcastView<Knot>& x0,
+                        const BroadcastView<Knot>& x1,
+                        const BroadcastView<Knot>& x2,
+                        Size begin,
+                        Size end,
+                        Out* y)
+{
+    auto buffer0 = std::array<Knot, eval_block_size>();
+    auto buffer1 = std::array<Knot, eval_block_size>();
+    auto buffer2 = std::array<Knot, eval_block_size>();
+    auto b0 = BasisBlock<Value>();
+    auto b1 = BasisBlock<Value>();
+    auto b2 = BasisBlock<Value>();
+    auto offset = std::array<Size, eval_block_size>();
+    auto acc = ResultBlock<Value>();
+
+    for (Size first = begin; first < end; first += eval_block_size) {
+        const auto count = std::min(eval_block_size, end - first);
+        basis0.eval_block(x0.get(first, count, buffer0.data()), count, b0);
+        basis1.eval_block(x1.get(first, count, buffer1.data()), count, b1);
+        basis2.eval_block(x2.get(first, count, buffer2.data()), count, b2);
+
+        for (Size k = 0; k < count; ++k) {
+            offset[k] = b0.interval[k] * stride0 + b1.interval[k] * stride1 +
+                        b2.interval[k];
+            acc[k] = Value{0};
+        }
+
+        for (Size i = 0; i < 4; ++i) {
+            for (Size j = 0; j < 4; ++j) {
+                const auto* c = control_points + i * stride0 + j * stride1;
+                for (Size k = 0; k < count; ++k) {
+                    const auto* ck = c + offset[k];
+                    const auto t = b2.weights[0][k] * ck[0] + b2.weights[1][k] * ck[1] +
+                                   b2.weights[2][k] * ck[2] + b2.weights[3][k] * ck[3];
+                    acc[k] += b0.weights[i][k] * b1.weights[j][k] * t;
+                }
+            }
+        }
+        store_block(acc, count, y + first);
+    }
+}
+
+// Evaluate partial derivatives of an N-dimensional tensor-product cubic B-spline at the
+// points in the range [begin, end).
+//
+// `orders[d][a]` is the order of the derivative along axis `a` of the d-th output,
+// which is written to `y[d * y_stride + k]` for the k-th point. The control points are
+// stored in row-major order with `strides[a]` elements between consecutive indices
+// along axis `a`.
+//
+// The basis weights along each axis are computed once for all outputs. Then, for each
+// of the 4^(N-1) runs of 4 adjacent control points in the stencil of a block of points,
+// the contribution of the run to every output is accumulated while it is in cache, so
+// the stencil is traversed only once regardless of the number of outputs.
+template<Size N, class Basis, class Knot, class Value, class Out>
+void
+eval_derivatives(const std::array<const BlockBasis<Basis>*, N>& bases,
+                 const Value* control_points,
+                 const std::array<Size, N>& strides,
+                 const std::array<const BroadcastView<Knot>*, N>& x,
+                 std::span<const std::array<Size, N>> orders,
+                 Size begin,
+                 Size end,
+                 Out* y,
+                 Size y_stride)
+{
+    static_assert(N >= 1);
+    WHIRLWIND_ASSERT(strides[N - 1] == 1);
+
+    // The highest order of derivative required along each axis.
+    auto max_order = std::array<Size, N>();
+    for (const auto& order : orders) {
+        for (Size a = 0; a < N; ++a) {
+            WHIRLWIND_ASSERT(order[a] <= max_derivative_order);
+            max_order[a] = std::max(max_order[a], order[a]);
+        }
+    }
+
+    auto buffers = std::array<std::array<Knot, eval_block_size>, N>();
+    auto blocks = std::array<BasisDerivativeBlock<Value>, N>();
+    auto offset = std::array<Size, eval_block_size>();
+    auto acc = std::vector<ResultBlock<Value>>(orders.size());
+
+    // The number of runs of control points in the stencil of each point.
+    constexpr auto num_runs = Size{1} << (2 * (N - 1));
+
+    for (Size first = begin; first < end; first += eval_block_size) {
+        const auto count = std::min(eval_block_size, end - first);
+        for (Size a = 0; a < N; ++a) {
+            const auto* xa = x[a]->get(first, count, buffers[a].data());
+            bases[a]->eval_derivative_block(xa, count, max_order[a], blocks[a]);
+        }
+
+        for (Size k = 0; k < count; ++k) {
+            offset[k] = 0;
+            for (Size a = 0; a < N; ++a) {
+                offset[k] += blocks[a].interval[k] * strides[a];
+            }
+        }
+        for (auto& a : acc) {
+            std::fill_n(a.begin(), count, Value{0});
+        }
+
+        for (Size run = 0; run < num_runs; ++run) {
+            // Unravel the index of the run into a position along each leading axis.
+            auto pos = std::array<Size, N>();
+            Size base = 0;
+            for (Size a = N - 1, r = run; a-- > 0; r /= 4) {
+                pos[a] = r % 4;
+                base += pos[a] * strides[a];
+            }
+            const auto* c = control_points + base;
+
+            for (Size d = 0; d < orders.size(); ++d) {
+                const auto& order = orders[d];
+                const auto& w = blocks[N - 1].weights[order[N - 1]];
+                auto& out = acc[d];
+                for (Size k = 0; k < count; ++k) {
+                    const auto* ck = c + offset[k];
+                    auto t = w[0][k] * ck[0] + w[1][k] * ck[1] + w[2][k] * ck[2] +
+                             w[3][k] * ck[3];
+                    for (Size a = 0; a + 1 < N; ++a) {
+                        t *= blocks[a].weights[order[a]][pos[a]][k];
+                    }
+                    out[k] += t;
+                }
+            }
+        }
+        for (Size d = 0; d < orders.size(); ++d) {
+            store_block(acc[d], count, y + d * y_stride + first);
+        }
+    }
+}
+
+// Split `size` points into blocks and call `func(begin, end)` on contiguous runs of
+// whole blocks concurrently.
+template<class Func>
+void
+parallel_for_blocks(Size size, Size num_threads, Func&& func)
+{
+    const auto num_blocks = (size + eval_block_size - 1) / eval_block_size;
+    parallel_for(num_blocks, num_threads, [&](Size begin, Size end) {
+        const auto first = std::min(begin * eval_block_size, size);
+        const auto last = std::min(end * eval_block_size, size);
+        if (first < last) {
+            func(first, last);
+        }
+    });
+}
+
+// Evaluate a `CubicBSpline` at `size` points, writing the results to `y`.
+template<class Spline, class Knot, class Out>
+void
+eval_spline_into(const Spline& spline,
+                 const BroadcastView<Knot>& x,
+                 Size size,
+                 Out* y,
+                 Size num_threads = 0)
+{
+    using Basis = typename Spline::basis_type;
+
+    const auto basis = BlockBasis<Basis>(spline.knots());
+    const auto* control_points = spline.control_points().data();
+
+    parallel_for_blocks(size, num_threads, [&](Size begin, Size end) {
+        eval_cubic_b_spline(basis, control_points, x, begin, end, y);
+    });
+}
+
+// Evaluate a `BiCubicBSpline` at `size` points, writing the results to `y`.
+template<class Spline, class Knot, class Out>
+void
+eval_spline_into(const Spline& spline,
+                 const BroadcastView<Knot>& x0,
+                 const BroadcastView<Knot>& x1,
+                 Size size,
+                 Out* y,
+                 Size num_threads = 0)
+{
+    using Basis = typename Spline::basis_type;
+
+    const auto basis0 = BlockBasis<Basis>(spline.knots(0));
+    const auto basis1 = BlockBasis<Basis>(spline.knots(1));
+    const auto& control_points = spline.control_points();
+    const auto stride0 = static_cast<Size>(control_points.extent(1));
+
+    parallel_for_blocks(size, num_threads, [&](Size begin, Size end) {
+        eval_bi_cubic_b_spline(basis0, basis1, control_points.data(), stride0, x0, x1,
+                               begin, end, y);
+    });
+}
+
+// Evaluate a `TriCubicBSpline` at `size` points, writing the results to `y`.
+template<class Spline, class Knot, class Out>
+void
+eval_spline_into(const Spline& spline,
+                 const BroadcastView<Knot>& x0,
+                 const BroadcastView<Knot>& x1,
+                 const BroadcastView<Knot>& x2,
+                 Size size,
+                 Out* y,
+                 Size num_threads = 0)
+{
+    using Basis = typename Spline::basis_type;
+
+    const auto basis0 = BlockBasis<Basis>(spline.knots(0));
+    const auto basis1 = BlockBasis<Basis>(spline.knots(1));
+    const auto basis2 = BlockBasis<Basis>(spline.knots(2));
+    const auto& control_points = spline.control_points();
+    const auto stride1 = static_cast<Size>(control_points.extent(2));
+    const auto stride0 = static_cast<Size>(control_points.extent(1)) * stride1;
+
+    parallel_for_blocks(size, num_threads, [&](Size begin, Size end) {
+        eval_tri_cubic_b_spline(basis0, basis1, basis2, control_points.data(), stride0,
+                                stride1, x0, x1, x2, begin, end, y);
+    });
+}
+
+// Evaluate a `CubicBSpline` at `size` points. Returns the results as a new array.
+template<class Spline, class Knot>
+[[nodiscard]] auto
+eval_spline(const Spline& spline,
+            const BroadcastView<Knot>& x,
+            Size size,
+            Size num_threads = 0) -> std::vector<typename Spline::value_type>
+{
+    auto y = std::vector<typename Spline::value_type>(size);
+    eval_spline_into(spline, x, size, y.data(), num_threads);
+    return y;
+}
+
+// Evaluate a `BiCubicBSpline` at `size` points. Returns the results as a new array.
+template<class Spline, class Knot>
+[[nodiscard]] auto
+eval_spline(const Spline& spline,
+            const BroadcastView<Knot>& x0,
+            const BroadcastView<Knot>& x1,
+            Size size,
+            Size num_threads = 0) -> std::vector<typename Spline::value_type>
+{
+    auto y = std::vector<typename Spline::value_type>(size);
+    eval_spline_into(spline, x0, x1, size, y.data(), num_threads);
+    return y;
+}
+
+// Evaluate a `TriCubicBSpline` at `size` points. Returns the results as a new array.
+template<class Spline, class Knot>
+[[nodiscard]] auto
+eval_spline(const Spline& spline,
+            const BroadcastView<Knot>& x0,
+            const BroadcastView<Knot>& x1,
+            const BroadcastView<Knot>& x2,
+            Size size,
+            Size num_threads = 0) -> std::vector<typename Spline::value_type>
+{
+    auto y = std::vector<typename Spline::value_type>(size);
+    eval_spline_into(spline, x0, x1, x2, size, y.data(), num_threads);
+    return y;
+}
+
+// Evaluate the partial derivatives of an N-dimensional `CubicBSpline`,
+// `BiCubicBSpline` or `TriCubicBSpline` at `size` points. The results are written to
+// `y` as a row-major array of shape (orders.size(), size).
+template<Size N, class Spline, class Knot, class Out>
+void
+eval_spline_derivatives_into(const Spline& spline,
+                             const std::array<BroadcastView<Knot>, N>& x,
+                             Size size,
+                             std::span<const std::array<Size, N>> orders,
+                             Out* y,
+                             Size num_threads = 0)
+{
+    using Basis = typename Spline::basis_type;
+
+    const auto& control_points = spline.control_points();
+
+    auto bases = std::vector<BlockBasis<Basis>>();
+    bases.reserve(N);
+    if constexpr (N == 1) {
+        bases.emplace_back(spline.knots());
+    } else {
+        for (Size a = 0; a < N; ++a) {
+            bases.emplace_back(spline.knots(a));
+        }
+    }
+
+    auto strides = std::array<Size, N>();
+    strides[N - 1] = 1;
+    for (Size a = N - 1; a-- > 0;) {
+        const auto extent = static_cast<Size>(control_points.extent(a + 1));
+        strides[a] = strides[a + 1] * extent;
+    }
+
+    auto basis_ptrs = std::array<const BlockBasis<Basis>*, N>();
+    auto x_ptrs = std::array<const BroadcastView<Knot>*, N>();
+    for (Size a = 0; a < N; ++a) {
+        basis_ptrs[a] = &bases[a];
+        x_ptrs[a] = &x[a];
+    }
+
+    parallel_for_blocks(size, num_threads, [&](Size begin, Size end) {
+        eval_derivatives(basis_ptrs, control_points.data(), strides, x_ptrs, orders,
+                         begin, end, y, size);
+    });
+}
+
+// Evaluate the partial derivatives of an N-dimensional `CubicBSpline`,
+// `BiCubicBSpline` or `TriCubicBSpline` at `size` points. Returns the results as a
+// new row-major array of shape (orders.size(), size).
+template<Size N, class Spline, class Knot>
+[[nodiscard]] auto
+eval_spline_derivatives(const Spline& spline,
+                        const std::array<BroadcastView<Knot>, N>& x,
+                        Size size,
+                        std::span<const std::array<Size, N>> orders,
+                        Size num_threads = 0)
+        -> std::vector<typename Spline::value_type>
+{
+    auto y = std::vector<typename Spline::value_type>(orders.size() * size);
+    eval_spline_derivatives_into<N>(spline, x, size, orders, y.data(), num_threads);
+    return y;
+}
+
+// Contract the control points of a `TriCubicBSpline` along one axis at a fixed
+// coordinate.
+//
+// Returns the control points of the `BiCubicBSpline` over the two remaining axes that
+// is equal to the 3-D spline restricted to the plane `x[axis] == x`, along with their
+// shape. Each output control point is a 4-term weighted sum of input control points.
+// Throws `std::invalid_argument` if `x` is outside the range of the knots along `axis`.
+template<class Spline, class Knot>
+[[nodiscard]] auto
+slice_control_points(const Spline& spline, Size axis, const Knot& x)
+        -> std::pair<std::vector<typename Spline::value_type>, std::array<Size, 2>>
+{
+    using Value = typename Spline::value_type;
+    using Basis = typename Spline::basis_type;
+
+    WHIRLWIND_ASSERT(axis < 3);
+
+    const auto knots = spline.knots(axis);
+    const auto num_knots = static_cast<Size>(knots.size());
+    WHIRLWIND_ASSERT(num_knots >= 2);
+    if (!(x >= knots.front() && x <= knots.back())) {
+        throw std::invalid_argument("x must be within the knot range of the axis");
+    }
+
+    // Clamp the interval as `BlockBasis` does, so that a point on the last knot uses
+    // the last interval rather than reading control points past the end.
+    const auto basis = Basis(knots);
+    const auto i =
+            std::min(static_cast<Size>(basis.get_knot_interval(x)), num_knots - 2);
+    const auto w = basis.eval_in_interval(x, i);
+
+    const auto& control_points = spline.control_points();
+    auto extent = std::array<Size, 3>();
+    for (Size d = 0; d < 3; ++d) {
+        extent[d] = static_cast<Size>(control_points.extent(d));
+    }
+    const auto* c = control_points.data();
+
+    // View the control points as an (outer, extent[axis], inner) array, so that the
+    // contraction is a weighted sum of 4 consecutive (outer, inner) slices.
+    Size outer = 1;
+    for (Size d = 0; d < axis; ++d) {
+        outer *= extent[d];
+    }
+    Size inner = 1;
+    for (Size d = axis + 1; d < 3; ++d) {
+        inner *= extent[d];
+    }
+
+    auto out = std::vector<Value>(outer * inner, Value{0});
+    for (Size o = 0; o < outer; ++o) {
+        auto* dst = out.data() + o * inner;
+        for (Size q = 0; q < 4; ++q) {
+            const auto* src = c + (o * extent[axis] + i + q) * inner;
+            const auto wq = static_cast<Value>(w[q]);
+            for (Size k = 0; k < inner; ++k) {
+                dst[k] += wq * src[k];
+            }
+        }
+    }
+
+    auto shape = std::array<Size, 2>();
+    for (Size d = 0, j = 0; d < 3; ++d) {
+        if (d != axis) {
+            shape[j++] = extent[d];
+        }
+    }
+
+    return {std::move(out), shape};
+}
+
+} // namespace whirlwind::bindings
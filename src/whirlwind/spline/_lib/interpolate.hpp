@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
+
+#include "parallel.hpp"
+
+namespace whirlwind::bindings {
+
+// The LU factorization of a tridiagonal matrix with partial pivoting, as computed by
+// LAPACK's ?gttrf.
+//
+// `dl`, `d` & `du` initially hold the sub-, main and super-diagonals of the matrix and
+// are overwritten by the factors. Row interchanges introduce fill-in in the second
+// super-diagonal, which is stored in `du2`.
+template<class T>
+struct TridiagonalLU {
+    std::vector<T> dl;
+    std::vector<T> d;
+    std::vector<T> du;
+    std::vector<T> du2;
+    std::vector<Size> ipiv;
+
+    TridiagonalLU(std::vector<T> dl_, std::vector<T> d_, std::vector<T> du_)
+        : dl(std::move(dl_)), d(std::move(d_)), du(std::move(du_))
+    {
+        const auto n = static_cast<Size>(d.size());
+        WHIRLWIND_ASSERT(n >= 2);
+        WHIRLWIND_ASSERT(dl.size() == n - 1);
+        WHIRLWIND_ASSERT(du.size() == n - 1);
+
+        du2.assign(n - 2, T{0});
+        ipiv.resize(n);
+        for (Size i = 0; i < n; ++i) {
+            ipiv[i] = i;
+        }
+
+        for (Size i = 0; i < n - 1; ++i) {
+            if (std::abs(d[i]) >= std::abs(dl[i])) {
+                // No row interchange required.
+                if (d[i] != T{0}) {
+                    const auto fact = dl[i] / d[i];
+                    dl[i] = fact;
+                    d[i + 1] -= fact * du[i];
+                }
+            } else {
+                // Interchange rows i & i+1.
+                const auto fact = d[i] / dl[i];
+                d[i] = dl[i];
+                dl[i] = fact;
+                const auto temp = du[i];
+                du[i] = d[i + 1];
+                d[i + 1] = temp - fact * d[i + 1];
+                if (i + 2 < n) {
+                    du2[i] = du[i + 1];
+                    du[i + 1] = -fact * du[i + 1];
+                }
+                ipiv[i] = i + 1;
+            }
+        }
+
+        for (Size i = 0; i < n; ++i) {
+            WHIRLWIND_ASSERT(d[i] != T{0});
+        }
+    }
+
+    [[nodiscard]] auto
+    size() const noexcept -> Size
+    {
+        return static_cast<Size>(d.size());
+    }
+
+    // Solve the system in-place for `count` right-hand sides at once. The j-th element
+    // of the k-th right-hand side is stored at `b[j * stride + k]`, so the innermost
+    // loops run over contiguous memory and may be vectorized.
+    template<class Value>
+    void
+    solve(Value* b, Size stride, Size count) const
+    {
+        const auto n = size();
+        const auto row = [&](Size j) { return b + j * stride; };
+
+        // Solve L * x = b.
+        for (Size i = 0; i < n - 1; ++i) {
+            auto* bi = row(i);
+            auto* bi1 = row(i + 1);
+            const auto l = static_cast<Value>(dl[i]);
+            if (ipiv[i] == i) {
+                for (Size k = 0; k < count; ++k) {
+                    bi1[k] -= l * bi[k];
+                }
+            } else {
+                for (Size k = 0; k < count; ++k) {
+                    const auto temp = bi[k] - l * bi1[k];
+                    bi[k] = bi1[k];
+                    bi1[k] = temp;
+                }
+            }
+        }
+
+        // Solve U * x = b.
+        {
+            auto* bn = row(n - 1);
+            const auto dn = static_cast<Value>(d[n - 1]);
+            for (Size k = 0; k < count; ++k) {
+                bn[k] /= dn;
+            }
+        }
+        {
+            auto* bi = row(n - 2);
+            const auto* bi1 = row(n - 1);
+            const auto u = static_cast<Value>(du[n - 2]);
+            const auto di = static_cast<Value>(d[n - 2]);
+            for (Size k = 0; k < count; ++k) {
+                bi[k] = (bi[k] - u * bi1[k]) / di;
+            }
+        }
+        for (Size i = n - 2; i-- > 0;) {
+            auto* bi = row(i);
+            const auto* bi1 = row(i + 1);
+            const auto* bi2 = row(i + 2);
+            const auto u = static_cast<Value>(du[i]);
+            const auto u2 = static_cast<Value>(du2[i]);
+            const auto di = static_cast<Value>(d[i]);
+            for (Size k = 0; k < count; ++k) {
+                bi[k] = (bi[k] - u * bi1[k] - u2 * bi2[k]) / di;
+            }
+        }
+    }
+};
+
+// The linear system that maps the values of a cubic B-spline at each of its knots to
+// its control points, subject to "natural" boundary conditions (the second derivative
+// is zero at the first and last knot).
+//
+// The system is tridiagonal except for the two boundary rows, each of which has a third
+// nonzero coefficient. These are eliminated by row reduction with the adjacent row, so
+// the right-hand side of the first and last rows is a multiple of the first and last
+// value, respectively.
+template<class T>
+struct CubicBSplineInterpolant {
+    TridiagonalLU<T> lu;
+    T first_scale;
+    T last_scale;
+};
+
+template<class Basis>
+[[nodiscard]] auto
+make_cubic_b_spline_interpolant(const Basis& basis)
+        -> CubicBSplineInterpolant<typename Basis::knot_type>
+{
+    using T = typename Basis::knot_type;
+
+    const auto knots = basis.knots();
+    const auto n = static_cast<Size>(knots.size());
+    WHIRLWIND_ASSERT(n >= 2);
+
+    auto dl = std::vector<T>();
+    auto d = std::vector<T>();
+    auto du = std::vector<T>();
+    dl.reserve(n + 1);
+    d.reserve(n + 2);
+    du.reserve(n + 1);
+
+    // First row (boundary condition), after row reduction with the second row.
+    const auto s0 = basis.eval_second_derivative_in_interval(knots[0], 0);
+    const auto w0 = basis.eval_in_interval(knots[0], 0);
+    const auto c0 = s0[2];
+    d.push_back(s0[0] - c0 * w0[0] / w0[2]);
+    du.push_back(s0[1] - c0 * w0[1] / w0[2]);
+    const auto first_scale = -c0 / w0[2];
+
+    // Interior rows: the spline must match the value at each knot.
+    dl.push_back(w0[0]);
+    d.push_back(w0[1]);
+    du.push_back(w0[2]);
+    for (Size i = 1; i < n - 1; ++i) {
+        const auto w = basis.eval_in_interval(knots[i], i);
+        dl.push_back(w[0]);
+        d.push_back(w[1]);
+        du.push_back(w[2]);
+    }
+    const auto w1 = basis.eval_in_interval(knots[n - 1], n - 2);
+    dl.push_back(w1[1]);
+    d.push_back(w1[2]);
+    du.push_back(w1[3]);
+
+    // Last row (boundary condition), after row reduction with the second-to-last row.
+    const auto s1 = basis.eval_second_derivative_in_interval(knots[n - 1], n - 2);
+    const auto c1 = s1[1];
+    dl.push_back(s1[2] - c1 * w1[2] / w1[1]);
+    d.push_back(s1[3] - c1 * w1[3] / w1[1]);
+    const auto last_scale = -c1 / w1[1];
+
+    auto lu = TridiagonalLU<T>(std::move(dl), std::move(d), std::move(du));
+    return {std::move(lu), first_scale, last_scale};
+}
+
+// Fit the control points of a cubic B-spline to a batch of data along one axis.
+//
+// `values` is a row-major array of shape (outer, n, inner), where n is the number of
+// knots of `basis`. Each of the (outer * inner) lines along the middle axis is
+// interpolated independently. Returns the control points as a row-major array of shape
+// (outer, n + 2, inner).
+//
+// The basis matrix is factored once and reused for every line. Lines are solved in
+// blocks of adjacent columns in parallel.
+template<class Basis, class Value>
+[[nodiscard]] auto
+interpolate_control_points(const Basis& basis,
+                           std::span<const Value> values,
+                           Size outer,
+                           Size inner,
+                           Size num_threads = 0) -> std::vector<Value>
+{
+    const auto interpolant = make_cubic_b_spline_interpolant(basis);
+    const auto m = interpolant.lu.size();
+    const auto n = m - 2;
+    WHIRLWIND_ASSERT(values.size() == outer * n * inner);
+
+    const auto first_scale = static_cast<Value>(interpolant.first_scale);
+    const auto last_scale = static_cast<Value>(interpolant.last_scale);
+
+    // The number of adjacent lines solved together by each task.
+    constexpr Size block_size = 64;
+    const auto num_blocks = (inner + block_size - 1) / block_size;
+
+    auto control_points = std::vector<Value>(outer * m * inner);
+    parallel_for(outer * num_blocks, num_threads, [&](Size begin, Size end) {
+        for (Size task = begin; task < end; ++task) {
+            const auto o = task / num_blocks;
+            const auto k0 = (task % num_blocks) * block_size;
+            const auto count = std::min(block_size, inner - k0);
+
+            const auto* src = values.data() + o * n * inner + k0;
+            auto* dst = control_points.data() + o * m * inner + k0;
+
+            // Assemble the right-hand sides.
+            for (Size k = 0; k < count; ++k) {
+                dst[k] = first_scale * src[k];
+            }
+            for (Size j = 0; j < n; ++j) {
+                std::copy_n(src + j * inner, count, dst + (j + 1) * inner);
+            }
+            for (Size k = 0; k < count; ++k) {
+                dst[(m - 1) * inner + k] = last_scale * src[(n - 1) * inner + k];
+            }
+
+            interpolant.lu.solve(dst, inner, count);
+        }
+    });
+
+    return control_points;
+}
+
+} // namespace whirlwind::bindings
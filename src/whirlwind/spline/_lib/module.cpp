@@ -13,6 +13,7 @@ namespace nb = nanobind;
 void bi_cubic_b_spline(nb::module_&);
 void cubic_b_spline(nb::module_&);
 void cubic_b_spline_basis(nb::module_&);
+void spline_file(nb::module_&);
 void tri_cubic_b_spline(nb::module_&);
 // clang-format on
 
@@ -27,6 +28,7 @@ NB_MODULE(_lib, m)
     m.attr("__version_tuple__") =
             std::pair(WHIRLWIND_VERSION_MAJOR, WHIRLWIND_VERSION_MINOR);
 
+    whirlwind::bindings::spline_file(m);
     whirlwind::bindings::cubic_b_spline_basis(m);
     whirlwind::bindings::cubic_b_spline(m);
     whirlwind::bindings::bi_cubic_b_spline(m);
@@ -0,0 +1,74 @@
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include <nanobind/nanobind.h>
+#include <nanobind/stl/filesystem.h>
+#include <nanobind/stl/vector.h>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
+
+#include "array.hpp"
+#include "spline_file.hpp"
+
+namespace whirlwind::bindings {
+
+namespace nb = nanobind;
+using namespace nb::literals;
+
+// Add a function that writes the knots along each axis and the samples of a function
+// at the knots to a spline file with elements of type `T`.
+template<class T>
+void
+save_spline_samples(nb::module_& m)
+{
+    m.def(
+            "save_spline_samples",
+            [](const std::filesystem::path& path,
+               const std::vector<PyContiguousArray1D<const T>>& knots,
+               const PyContiguousArray<const T>& samples) {
+                WHIRLWIND_ASSERT(samples.ndim() == knots.size());
+                auto knot_spans = std::vector<std::span<const T>>();
+                knot_spans.reserve(knots.size());
+                for (Size d = 0; d < knots.size(); ++d) {
+                    WHIRLWIND_ASSERT(samples.shape(d) == knots[d].size());
+                    knot_spans.emplace_back(knots[d].data(), knots[d].size());
+                }
+
+                [[maybe_unused]] const nb::gil_scoped_release nogil;
+                save_spline_file<T>(path, knot_spans, {},
+                                    std::span(samples.data(), samples.size()));
+            },
+            "path"_a, "knots"_a, "samples"_a);
+}
+
+void
+spline_file(nb::module_& m)
+{
+    m.def(
+            "read_spline_file_info",
+            [](const std::filesystem::path& path) {
+                const auto info = [&]() {
+                    [[maybe_unused]] const nb::gil_scoped_release nogil;
+                    return read_spline_file_info(path);
+                }();
+                auto out = nb::dict();
+                out["num_dims"] = info.num_dims;
+                out["dtype"] = (info.dtype == SplineFileDType::f32) ? "float32"
+                                                                    : "float64";
+                out["has_control_points"] = info.has_control_points;
+                out["has_samples"] = info.has_samples;
+                out["num_knots"] = info.num_knots;
+                out["knot_offsets"] = info.knot_offsets;
+                out["control_points_offset"] = info.control_points_offset;
+                out["samples_offset"] = info.samples_offset;
+                return out;
+            },
+            "path"_a);
+
+    save_spline_samples<float>(m);
+    save_spline_samples<double>(m);
+}
+
+} // namespace whirlwind::bindings
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <whirlwind/common/assert.hpp>
+#include <whirlwind/common/stddef.hpp>
+
+namespace whirlwind::bindings {
+
+// A compact binary file format for cubic B-spline bases and splines, and for functions
+// sampled on the grid of knots.
+//
+// The file begins with a fixed-size header, followed by the number of knots along each
+// axis. Then, the knots along each axis, (optionally) the control points, and
+// (optionally) the samples are stored as raw little-endian arrays. The control points
+// are stored in row-major order with shape (n0 + 2, n1 + 2, ...), and the samples with
+// shape (n0, n1, ...), where n0, n1, ... are the number of knots along each axis.
+//
+// Each array begins at an offset that is a multiple of `spline_file_alignment` bytes,
+// which is recorded in `SplineFileInfo`. `load_spline_file()` copies the knots and
+// control points into the containers owned by the spline classes, while the samples
+// are meant to be memory-mapped and used in place (see `load_samples()` in
+// `_spline_file.py`).
+//
+// | Offset | Type        | Contents                                          |
+// |--------|-------------|---------------------------------------------------|
+// | 0      | char[8]     | "WWSPLINE"                                        |
+// | 8      | uint32      | Format version                                    |
+// | 12     | uint32      | Number of dimensions, N (1 to 3)                  |
+// | 16     | uint32      | Element type (`SplineFileDType`)                  |
+// | 20     | uint32      | Flags (bit 0: the file contains control points,   |
+// |        |             | bit 1: the file contains samples)                 |
+// | 24     | uint64[N]   | Number of knots along each axis                   |
+inline constexpr std::array<char, 8> spline_file_magic = {'W', 'W', 'S', 'P',
+                                                          'L', 'I', 'N', 'E'};
+inline constexpr std::uint32_t spline_file_version = 1;
+inline constexpr std::uint32_t spline_file_max_dims = 3;
+inline constexpr std::uint64_t spline_file_alignment = 64;
+inline constexpr std::uint32_t spline_file_has_control_points = 1;
+inline constexpr std::uint32_t spline_file_has_samples = 2;
+
+enum class SplineFileDType : std::uint32_t { f32 = 0, f64 = 1 };
+
+template<class T>
+[[nodiscard]] constexpr auto
+spline_file_dtype() noexcept -> SplineFileDType
+{
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>);
+    return std::is_same_v<T, float> ? SplineFileDType::f32 : SplineFileDType::f64;
+}
+
+// The header of a spline file, along with the byte offset of each array in the file.
+// The offsets of arrays that are not present are zero.
+struct SplineFileInfo {
+    Size num_dims;
+    SplineFileDType dtype;
+    bool has_control_points;
+    bool has_samples;
+    std::vector<Size> num_knots;
+    std::vector<Size> knot_offsets;
+    Size control_points_offset = 0;
+    Size samples_offset = 0;
+};
+
+namespace detail {
+
+static_assert(std::endian::native == std::endian::little,
+              "spline files are only supported on little-endian platforms");
+
+[[nodiscard]] inline auto
+align_spline_file_offset(std::uint64_t offset) noexcept -> std::uint64_t
+{
+    const auto a = spline_file_alignment;
+    return (offset + a - 1) / a * a;
+}
+
+template<class T>
+void
+write_raw(std::ofstream& file, const T* data, std::uint64_t count)
+{
+    file.write(reinterpret_cast<const char*>(data),
+               static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template<class T>
+void
+read_raw(std::ifstream& file, T* data, std::uint64_t count)
+{
+    file.read(reinterpret_cast<char*>(data),
+              static_cast<std::streamsize>(count * sizeof(T)));
+    if (!file) {
+        throw std::runtime_error("unexpected end of spline file");
+    }
+}
+
+// Write zero bytes until the file offset is aligned.
+inline void
+write_padding(std::ofstream& file, std::uint64_t& offset)
+{
+    const auto aligned = align_spline_file_offset(offset);
+    constexpr auto zeros = std::array<char, spline_file_alignment>();
+    file.write(zeros.data(), static_cast<std::streamsize>(aligned - offset));
+    offset = aligned;
+}
+
+[[nodiscard]] inline auto
+read_spline_file_info(std::ifstream& file) -> SplineFileInfo
+{
+    auto magic = std::array<char, 8>();
+    read_raw(file, magic.data(), magic.size());
+    if (magic != spline_file_magic) {
+        throw std::runtime_error("not a spline file");
+    }
+
+    auto fields = std::array<std::uint32_t, 4>();
+    read_raw(file, fields.data(), fields.size());
+    const auto [version, num_dims, dtype, flags] = fields;
+    if (version != spline_file_version) {
+        throw std::runtime_error("unsupported spline file version " +
+                                 std::to_string(version));
+    }
+    if (num_dims < 1 || num_dims > spline_file_max_dims) {
+        throw std::runtime_error("invalid number of dimensions in spline file");
+    }
+    if (dtype != static_cast<std::uint32_t>(SplineFileDType::f32) &&
+        dtype != static_cast<std::uint32_t>(SplineFileDType::f64)) {
+        throw std::runtime_error("invalid element type in spline file");
+    }
+
+    auto num_knots = std::vector<std::uint64_t>(num_dims);
+    read_raw(file, num_knots.data(), num_knots.size());
+    for (const auto n : num_knots) {
+        if (n < 2) {
+            throw std::runtime_error("invalid number of knots in spline file");
+        }
+    }
+
+    auto info = SplineFileInfo{
+            num_dims,
+            static_cast<SplineFileDType>(dtype),
+            (flags & spline_file_has_control_points) != 0,
+            (flags & spline_file_has_samples) != 0,
+            std::vector<Size>(num_knots.begin(), num_knots.end()),
+            {}};
+
+    // Lay out the arrays in the same order as `save_spline_file()`.
+    const auto elem_size = (info.dtype == SplineFileDType::f32) ? sizeof(float)
+                                                                 : sizeof(double);
+    auto offset = static_cast<std::uint64_t>(file.tellg());
+    Size num_control_points = 1;
+    for (const auto n : num_knots) {
+        offset = align_spline_file_offset(offset);
+        info.knot_offsets.push_back(offset);
+        offset += n * elem_size;
+        num_control_points *= n + 2;
+    }
+    if (info.has_control_points) {
+        offset = align_spline_file_offset(offset);
+        info.control_points_offset = offset;
+        offset += num_control_points * elem_size;
+    }
+    if (info.has_samples) {
+        info.samples_offset = align_spline_file_offset(offset);
+    }
+
+    return info;
+}
+
+} // namespace detail
+
+// Write the knots along each axis of a cubic B-spline basis or spline, and (if not
+// empty) its control points and the samples of a function at the knots, to a file.
+template<class T>
+void
+save_spline_file(const std::filesystem::path& path,
+                 std::span<const std::span<const T>> knots,
+                 std::span<const T> control_points = {},
+                 std::span<const T> samples = {})
+{
+    const auto num_dims = static_cast<std::uint32_t>(knots.size());
+    WHIRLWIND_ASSERT(num_dims >= 1 && num_dims <= spline_file_max_dims);
+
+    const auto has_control_points = !control_points.empty();
+    if (has_control_points) {
+        Size expected_size = 1;
+        for (const auto& k : knots) {
+            expected_size *= k.size() + 2;
+        }
+        WHIRLWIND_ASSERT(control_points.size() == expected_size);
+    }
+    const auto has_samples = !samples.empty();
+    if (has_samples) {
+        Size expected_size = 1;
+        for (const auto& k : knots) {
+            expected_size *= k.size();
+        }
+        WHIRLWIND_ASSERT(samples.size() == expected_size);
+    }
+
+    auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("failed to open spline file for writing: " +
+                                 path.string());
+    }
+
+    auto flags = std::uint32_t{0};
+    if (has_control_points) {
+        flags |= spline_file_has_control_points;
+    }
+    if (has_samples) {
+        flags |= spline_file_has_samples;
+    }
+    const auto fields = std::array<std::uint32_t, 4>{
+            spline_file_version, num_dims,
+            static_cast<std::uint32_t>(spline_file_dtype<T>()), flags};
+    detail::write_raw(file, spline_file_magic.data(), spline_file_magic.size());
+    detail::write_raw(file, fields.data(), fields.size());
+    for (const auto& k : knots) {
+        const auto n = static_cast<std::uint64_t>(k.size());
+        detail::write_raw(file, &n, 1);
+    }
+
+    const auto header_size = sizeof(spline_file_magic) + sizeof(fields) +
+                             num_dims * sizeof(std::uint64_t);
+    auto offset = static_cast<std::uint64_t>(header_size);
+    for (const auto& k : knots) {
+        detail::write_padding(file, offset);
+        detail::write_raw(file, k.data(), k.size());
+        offset += k.size() * sizeof(T);
+    }
+    if (has_control_points) {
+        detail::write_padding(file, offset);
+        detail::write_raw(file, control_points.data(), control_points.size());
+        offset += control_points.size() * sizeof(T);
+    }
+    if (has_samples) {
+        detail::write_padding(file, offset);
+        detail::write_raw(file, samples.data(), samples.size());
+    }
+
+    if (!file) {
+        throw std::runtime_error("failed to write spline file: " + path.string());
+    }
+}
+
+// Read the header of a spline file.
+[[nodiscard]] inline auto
+read_spline_file_info(const std::filesystem::path& path) -> SplineFileInfo
+{
+    auto file = std::ifstream(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("failed to open spline file: " + path.string());
+    }
+    return detail::read_spline_file_info(file);
+}
+
+// The contents of a spline file.
+template<class T>
+struct SplineFileContents {
+    std::vector<std::vector<T>> knots;
+    std::vector<T> control_points;
+};
+
+// Read a spline file with `num_dims` dimensions and elements of type `T`. If
+// `require_control_points` is true, the file must contain control points; otherwise,
+// any control points in the file are ignored.
+template<class T>
+[[nodiscard]] auto
+load_spline_file(const std::filesystem::path& path,
+                 Size num_dims,
+                 bool require_control_points) -> SplineFileContents<T>
+{
+    auto file = std::ifstream(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("failed to open spline file: " + path.string());
+    }
+
+    const auto info = detail::read_spline_file_info(file);
+    if (info.num_dims != num_dims) {
+        throw std::runtime_error("spline file has " + std::to_string(info.num_dims) +
+                                 " dimensions, expected " + std::to_string(num_dims));
+    }
+    if (info.dtype != spline_file_dtype<T>()) {
+        throw std::runtime_error("spline file has mismatched element type");
+    }
+    if (require_control_points && !info.has_control_points) {
+        throw std::runtime_error("spline file does not contain control points");
+    }
+
+    auto contents = SplineFileContents<T>();
+    contents.knots.reserve(num_dims);
+    Size num_control_points = 1;
+    for (Size d = 0; d < num_dims; ++d) {
+        const auto n = info.num_knots[d];
+        file.seekg(static_cast<std::streamoff>(info.knot_offsets[d]));
+        auto& k = contents.knots.emplace_back(n);
+        detail::read_raw(file, k.data(), n);
+        num_control_points *= n + 2;
+    }
+    if (require_control_points) {
+        file.seekg(static_cast<std::streamoff>(info.control_points_offset));
+        contents.control_points.resize(num_control_points);
+        detail::read_raw(file, contents.control_points.data(), num_control_points);
+    }
+
+    return contents;
+}
+
+} // namespace whirlwind::bindings
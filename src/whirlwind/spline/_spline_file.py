@@ -0,0 +1,101 @@
+import os
+from collections.abc import Sequence
+from typing import Any, Union
+
+import numpy as np
+from numpy.typing import ArrayLike
+
+from . import _lib
+
+__all__ = [
+    "load_samples",
+    "save_samples",
+]
+
+
+PathLike = Union[str, "os.PathLike[str]"]
+
+
+def _load_impl(path: PathLike, impl_f32: Any, impl_f64: Any) -> Any:
+    # Spline files record their element type, so dispatch to the extension class with
+    # the matching type.
+    info = _lib.read_spline_file_info(path)
+    if info["dtype"] == "float32":
+        return impl_f32.load(path)
+    else:
+        return impl_f64.load(path)
+
+
+def save_samples(
+    path: PathLike, knots: Sequence[ArrayLike], samples: ArrayLike
+) -> None:
+    """
+    Save the samples of a function on a regular grid to a spline file.
+
+    The file uses the same format as `CubicBSpline.save` and its multidimensional
+    counterparts, with the samples stored in place of the control points. It can be
+    read back with `load_samples`.
+
+    Parameters
+    ----------
+    path : str or os.PathLike
+        The path of the output file. An existing file is overwritten.
+    knots : sequence of array_like
+        The grid coordinates along each axis. Must contain 1 to 3 arrays.
+    samples : array_like
+        The function values at the grid nodes. Must have shape ``(len(knots[0]),
+        len(knots[1]), ...)``. Must have a floating-point type; the knots are converted
+        to the same type.
+    """
+    samples = np.ascontiguousarray(samples)
+    if samples.dtype not in (np.float32, np.float64):
+        msg = f"samples must be float32 or float64, got {samples.dtype}"
+        raise TypeError(msg)
+    knots = [np.ascontiguousarray(k, dtype=samples.dtype) for k in knots]
+    if samples.shape != tuple(len(k) for k in knots):
+        msg = (
+            f"samples shape {samples.shape} does not match the number of knots along"
+            " each axis"
+        )
+        raise ValueError(msg)
+
+    _lib.save_spline_samples(path, knots, samples)
+
+
+def load_samples(path: PathLike) -> tuple[tuple[np.ndarray, ...], np.ndarray]:
+    """
+    Load the samples of a function on a regular grid from a spline file.
+
+    The arrays are memory-mapped read-only from the file rather than copied.
+
+    Parameters
+    ----------
+    path : str or os.PathLike
+        The path of a file written by `save_samples`.
+
+    Returns
+    -------
+    knots : tuple of numpy.ndarray
+        The grid coordinates along each axis.
+    samples : numpy.ndarray
+        The function values at the grid nodes.
+    """
+    info = _lib.read_spline_file_info(path)
+    if not info["has_samples"]:
+        msg = f"spline file does not contain samples: {os.fspath(path)!r}"
+        raise ValueError(msg)
+
+    dtype = np.dtype(info["dtype"])
+    knots = tuple(
+        np.memmap(path, dtype=dtype, mode="r", offset=offset, shape=(n,))
+        for n, offset in zip(info["num_knots"], info["knot_offsets"])
+    )
+    samples = np.memmap(
+        path,
+        dtype=dtype,
+        mode="r",
+        offset=info["samples_offset"],
+        shape=tuple(info["num_knots"]),
+    )
+
+    return knots, samples
@@ -0,0 +1,103 @@
+import numpy as np
+import pytest
+
+from whirlwind._cost import compute_carballo_costs, load_carballo_pdf_splines
+from whirlwind.spline import load_samples, save_samples
+
+# Points (phase gradient, correlation, number of looks) at which the PDFs are checked,
+# and the values of the pickled `scipy.interpolate.RegularGridInterpolator` objects
+# that the PDF tables were converted from.
+PDF_POINTS = [
+    (0.0, 0.5, 1.0),
+    (0.3, 0.25, 4.0),
+    (-1.2, 0.8, 10.0),
+    (2.5, 0.95, 40.0),
+    (-3.0, 0.1, 79.0),
+    (1.0, 0.6, 2.5),
+]
+PDF0_VALUES = [
+    0.9017069510142206,
+    0.8985283422349939,
+    0.9999952883596681,
+    0.9999999999955996,
+    0.5469514905899852,
+    0.9546785784994715,
+]
+PDF1_VALUES = [
+    0.04954200287547525,
+    0.06761126530030252,
+    1.4975114003924255e-11,
+    4.346649359352736e-12,
+    6.457915774438861e-06,
+    0.044119424245913794,
+]
+
+
+def make_test_scene():
+    y, x = np.mgrid[:24, :32]
+    bump = np.where((x - 16) ** 2 + (y - 12) ** 2 < 40, 2.0, 0.0)
+    igram = np.exp(1j * (0.2 * x - 0.05 * y + 0.002 * x * y + bump))
+    corr = 0.2 + 0.7 * np.abs(np.sin(0.1 * x + 0.2 * y))
+    mask = np.zeros(igram.shape, dtype=bool)
+    mask[:4, :4] = True
+    return igram, corr, mask
+
+
+def test_pdfs_match_original_interpolants():
+    pdf0, pdf1 = load_carballo_pdf_splines()
+    np.testing.assert_allclose(pdf0(PDF_POINTS), PDF0_VALUES, rtol=1e-12)
+    np.testing.assert_allclose(pdf1(PDF_POINTS), PDF1_VALUES, rtol=1e-12)
+
+    # The grid spans [-pi, pi] x [0, 1] x [1, 80]; the PDFs are NaN outside of it.
+    for pdf in (pdf0, pdf1):
+        assert [(g[0], g[-1]) for g in pdf.grid] == [(-np.pi, np.pi), (0, 1), (1, 80)]
+        assert np.all(np.isnan(pdf([(0.0, 0.5, 0.5), (0.0, 1.5, 10.0)])))
+
+
+def test_pdfs_are_cached():
+    assert load_carballo_pdf_splines() is load_carballo_pdf_splines()
+
+
+@pytest.mark.parametrize(
+    ("nlooks", "use_mask", "expected_sum"),
+    [(5.0, False, 2102681), (20.0, True, 4415447)],
+)
+@pytest.mark.parametrize(("batch_size", "num_threads"), [(65536, 0), (100, 4), (7, 1)])
+def test_costs_match_original(nlooks, use_mask, expected_sum, batch_size, num_threads):
+    igram, corr, mask = make_test_scene()
+    mask = mask if use_mask else None
+    cost = compute_carballo_costs(
+        igram, corr, nlooks, mask, batch_size=batch_size, num_threads=num_threads
+    )
+
+    # `expected_sum` is the sum of the costs computed with the pickled interpolators.
+    assert cost.dtype == np.int32
+    assert cost.shape == (4 * 24 * 33,)
+    assert cost.sum() == expected_sum
+
+
+def test_samples_round_trip(tmp_path):
+    rng = np.random.default_rng(1234)
+    knots = (np.linspace(0.0, 1.0, 5), np.geomspace(1.0, 10.0, 3))
+    path = tmp_path / "samples.bin"
+
+    for dtype in (np.float32, np.float64):
+        samples = rng.standard_normal((5, 3)).astype(dtype)
+        save_samples(path, knots, samples)
+        loaded_knots, loaded_samples = load_samples(path)
+
+        assert loaded_samples.dtype == dtype
+        np.testing.assert_array_equal(loaded_samples, samples)
+        for a, b in zip(loaded_knots, knots):
+            np.testing.assert_array_equal(a, b.astype(dtype))
+
+        # The arrays are memory-mapped from the file rather than copied.
+        assert isinstance(loaded_samples, np.memmap)
+        assert not loaded_samples.flags.writeable
+        del loaded_knots, loaded_samples
+
+
+def test_save_samples_shape_mismatch(tmp_path):
+    knots = (np.linspace(0.0, 1.0, 5), np.linspace(0.0, 1.0, 3))
+    with pytest.raises(ValueError, match="does not match"):
+        save_samples(tmp_path / "samples.bin", knots, np.zeros((3, 5)))
@@ -0,0 +1,106 @@
+import numpy as np
+import pytest
+import scipy.sparse
+import scipy.sparse.csgraph
+
+import whirlwind as ww
+from whirlwind._lib import label_connected_components
+from whirlwind._unwrap import _get_connectivity
+
+
+def reference_labels(connected_x, connected_y, min_size):
+    nrows, ncols = connected_y.shape[0] + 1, connected_x.shape[1] + 1
+    index = np.arange(nrows * ncols).reshape(nrows, ncols)
+    rows = np.concatenate([index[:, :-1][connected_x], index[:-1, :][connected_y]])
+    cols = np.concatenate([index[:, 1:][connected_x], index[1:, :][connected_y]])
+    adjacency = scipy.sparse.coo_array(
+        (np.ones(len(rows)), (rows, cols)), shape=(index.size, index.size)
+    )
+    _, components = scipy.sparse.csgraph.connected_components(adjacency, directed=False)
+
+    # Label components by decreasing size, breaking ties by their first pixel.
+    sizes = np.bincount(components)
+    first = np.full(len(sizes), index.size)
+    np.minimum.at(first, components, np.arange(index.size))
+    order = np.lexsort((first, -sizes))
+    label_of = np.zeros(len(sizes), dtype=np.uint32)
+    kept = order[sizes[order] >= min_size]
+    label_of[kept] = np.arange(1, len(kept) + 1)
+    return label_of[components].reshape(nrows, ncols)
+
+
+@pytest.mark.parametrize("shape", [(1, 1), (1, 17), (23, 1), (40, 37)])
+@pytest.mark.parametrize("num_threads", [1, 4])
+@pytest.mark.parametrize("min_size", [1, 5])
+def test_label_connected_components(shape, num_threads, min_size):
+    rng = np.random.default_rng(0)
+    nrows, ncols = shape
+    connected_x = rng.random((nrows, ncols - 1)) < 0.6
+    connected_y = rng.random((nrows - 1, ncols)) < 0.6
+
+    labels = label_connected_components(
+        connected_x, connected_y, min_size=min_size, num_threads=num_threads
+    )
+    assert labels.dtype == np.uint32
+    assert labels.shape == shape
+    expected = reference_labels(connected_x, connected_y, min_size)
+    np.testing.assert_array_equal(labels, expected)
+
+
+def test_connectivity():
+    nrows, ncols = 3, 4
+    size_x = nrows * (ncols + 1)
+    size_y = (nrows + 1) * ncols
+    cost_up, cost_dn = np.full((2, size_x), 5)
+    cost_lt, cost_rt = np.full((2, size_y), 5)
+    flow_up, flow_dn = np.zeros((2, size_x), dtype=np.int32)
+    flow_lt, flow_rt = np.zeros((2, size_y), dtype=np.int32)
+
+    # A pair is disconnected if the arc across it in either direction is cheap, or if
+    # either arc carries flow. The arcs across each horizontally-adjacent pair
+    # (r,c)-(r,c+1) are at index r*(ncols+1)+c+1 of `up` & `dn`, and those across each
+    # vertically-adjacent pair (r,c)-(r+1,c) are at index (r+1)*ncols+c of `lt` & `rt`.
+    cost_up[1 * (ncols + 1) + 2] = 1
+    cost_rt[1 * ncols + 2] = 0
+    flow_dn[2 * (ncols + 1) + 1] = 1
+    flow_lt[2 * ncols + 0] = 2
+    cost = np.concatenate([cost_up, cost_lt, cost_dn, cost_rt])
+    flow = np.concatenate([flow_up, flow_lt, flow_dn, flow_rt])
+
+    connected_x, connected_y = _get_connectivity(cost, flow, (nrows, ncols), 1)
+    expected_x = np.ones((nrows, ncols - 1), dtype=np.bool_)
+    expected_x[1, 1] = False
+    expected_x[2, 0] = False
+    expected_y = np.ones((nrows - 1, ncols), dtype=np.bool_)
+    expected_y[0, 2] = False
+    expected_y[1, 0] = False
+    np.testing.assert_array_equal(connected_x, expected_x)
+    np.testing.assert_array_equal(connected_y, expected_y)
+
+
+@pytest.mark.parametrize("tile_shape", [None, (40, 40)])
+def test_unwrap_conncomp(tile_shape):
+    rng = np.random.default_rng(1)
+    y, x = np.mgrid[:96, :96]
+    # Noise creates residues, so that the solution has cycle discontinuities.
+    phase = 0.1 * x + 0.05 * y + rng.normal(scale=0.9, size=x.shape)
+    igram = np.exp(1j * phase).astype(np.complex64)
+    corr = np.full(igram.shape, 0.5, dtype=np.float32)
+
+    unwrapped, labels = ww.unwrap(
+        igram,
+        corr,
+        nlooks=4.0,
+        tile_shape=tile_shape,
+        tile_overlap=16,
+        return_conncomp=True,
+        conncomp_min_size=1,
+    )
+    assert labels.shape == igram.shape
+    assert np.any(labels > 0)
+
+    # Pixels in the same component are never separated by a cycle discontinuity.
+    same_x = (labels[:, 1:] == labels[:, :-1]) & (labels[:, 1:] > 0)
+    same_y = (labels[1:, :] == labels[:-1, :]) & (labels[1:, :] > 0)
+    assert np.all(np.abs(np.diff(unwrapped, axis=1))[same_x] < np.pi)
+    assert np.all(np.abs(np.diff(unwrapped, axis=0))[same_y] < np.pi)
@@ -0,0 +1,93 @@
+import numpy as np
+import pytest
+
+from whirlwind._contract import primal_dual_contracted
+from whirlwind.graph import RectangularGridGraph
+from whirlwind.network import Network, primal_dual
+
+
+def masked_grid_problem(seed):
+    rng = np.random.default_rng(seed)
+    graph = RectangularGridGraph(9, 11)
+    edges = graph.edge_array().astype(np.int64)
+    cost = rng.integers(1, 50, size=graph.num_edges).astype(np.int32)
+
+    # Edges between two masked vertices are free.
+    mask = np.zeros((9, 11), dtype=np.bool_)
+    mask[2:6, 3:8] = True
+    mask = mask.ravel()
+    cost[mask[edges[:, 0]] & mask[edges[:, 1]]] = 0
+
+    surplus = np.zeros(graph.num_vertices, dtype=np.int32)
+    vertices = rng.choice(graph.num_vertices, size=6, replace=False)
+    surplus[vertices[:3]] = 1
+    surplus[vertices[3:]] = -1
+    return graph, edges, surplus, cost
+
+
+def net_outflow(edges, flow, num_vertices):
+    tails, heads = edges[:, 0], edges[:, 1]
+    outflow = np.bincount(tails, weights=flow, minlength=num_vertices)
+    inflow = np.bincount(heads, weights=flow, minlength=num_vertices)
+    return (outflow - inflow).astype(np.int64)
+
+
+@pytest.mark.parametrize("seed", range(5))
+def test_contracted_matches_uncontracted(seed):
+    graph, edges, surplus, cost = masked_grid_problem(seed)
+
+    network = Network(graph, surplus, cost, capacity=1)
+    primal_dual(network)
+    expected = network.edge_flow_array().astype(np.int64)
+
+    contracted = primal_dual_contracted(graph, surplus, cost)
+    assert contracted.is_balanced()
+    flow = contracted.edge_flow_array().astype(np.int64)
+
+    assert np.all(flow >= 0)
+    assert np.all(flow[cost > 0] <= 1)
+    np.testing.assert_array_equal(net_outflow(edges, flow, len(surplus)), surplus)
+    assert np.dot(cost, flow) == np.dot(cost, expected)
+
+
+def test_contracted_single_component():
+    graph = RectangularGridGraph(4, 5)
+    edges = graph.edge_array().astype(np.int64)
+    cost = np.zeros(graph.num_edges, dtype=np.int32)
+    surplus = np.zeros(graph.num_vertices, dtype=np.int32)
+    surplus[0], surplus[-1] = 1, -1
+
+    network = primal_dual_contracted(graph, surplus, cost)
+    flow = network.edge_flow_array().astype(np.int64)
+    np.testing.assert_array_equal(net_outflow(edges, flow, len(surplus)), surplus)
+
+
+def test_contracted_unbalanced_component():
+    graph = RectangularGridGraph(4, 5)
+    cost = np.zeros(graph.num_edges, dtype=np.int32)
+    surplus = np.zeros(graph.num_vertices, dtype=np.int32)
+    surplus[0] = 1
+
+    with pytest.raises(ValueError, match="nonzero net excess"):
+        primal_dual_contracted(graph, surplus, cost)
+
+
+def test_increase_edge_flows():
+    graph = RectangularGridGraph(4, 5)
+    surplus = np.zeros(graph.num_vertices, dtype=np.int32)
+    cost = np.ones(graph.num_edges, dtype=np.int32)
+    network = Network(graph, surplus, cost)
+
+    delta = np.zeros(graph.num_edges, dtype=np.int32)
+    delta[::3] = 2
+    network.increase_edge_flows(delta)
+    np.testing.assert_array_equal(network.edge_flow_array(), delta)
+
+    # Invalid inputs are rejected without modifying any flows.
+    with pytest.raises(ValueError, match="one entry per edge"):
+        network.increase_edge_flows(delta[:-1])
+    bad_delta = np.ones(graph.num_edges, dtype=np.int32)
+    bad_delta[-1] = -1
+    with pytest.raises(ValueError, match="non-negative"):
+        network.increase_edge_flows(bad_delta)
+    np.testing.assert_array_equal(network.edge_flow_array(), delta)
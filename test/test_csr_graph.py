@@ -0,0 +1,107 @@
+import numpy as np
+import pytest
+import scipy.sparse
+
+from whirlwind.graph import CSRGraph, EdgeList
+
+
+@pytest.mark.parametrize("dtype", [np.int32, np.int64, np.uint32, np.uint64, np.int8])
+def test_from_edge_arrays(dtype):
+    tails = np.array([2, 0, 1, 0, 2], dtype=dtype)
+    heads = np.array([0, 1, 2, 2, 1], dtype=dtype)
+    graph, edge_ids = CSRGraph.from_edge_arrays(tails, heads)
+
+    assert graph.num_vertices == 3
+    assert graph.num_edges == 5
+    np.testing.assert_array_equal(np.sort(edge_ids), np.arange(5))
+
+    edges = graph.edge_array()
+    np.testing.assert_array_equal(edges[edge_ids, 0], tails)
+    np.testing.assert_array_equal(edges[edge_ids, 1], heads)
+
+    # Edges must be grouped by tail vertex.
+    assert np.all(np.diff(edges[:, 0].astype(np.int64)) >= 0)
+
+
+def test_from_edge_arrays_parallel_edges():
+    tails = np.array([1, 0, 1, 0, 1, 1])
+    heads = np.array([0, 1, 0, 0, 1, 0])
+    graph, edge_ids = CSRGraph.from_edge_arrays(tails, heads)
+
+    np.testing.assert_array_equal(np.sort(edge_ids), np.arange(6))
+    edges = graph.edge_array()
+    np.testing.assert_array_equal(edges[edge_ids, 0], tails)
+    np.testing.assert_array_equal(edges[edge_ids, 1], heads)
+
+    # Parallel edges are matched in order of appearance.
+    parallel = edge_ids[[0, 2, 5]]
+    assert np.all(np.diff(parallel.astype(np.int64)) > 0)
+
+
+def test_from_edge_arrays_num_vertices():
+    tails = [0, 3]
+    heads = [1, 2]
+    graph, _ = CSRGraph.from_edge_arrays(tails, heads, num_vertices=4)
+    assert graph.num_vertices == 4
+
+    with pytest.raises(ValueError, match="less than num_vertices"):
+        CSRGraph.from_edge_arrays(tails, heads, num_vertices=3)
+    with pytest.raises(ValueError, match="trailing isolated vertices"):
+        CSRGraph.from_edge_arrays(tails, heads, num_vertices=5)
+
+
+def test_from_edge_arrays_invalid():
+    with pytest.raises(ValueError, match="negative"):
+        CSRGraph.from_edge_arrays([0, -1], [1, 0])
+    with pytest.raises(ValueError, match="same length"):
+        CSRGraph.from_edge_arrays([0, 1], [1])
+    with pytest.raises(TypeError, match="integers"):
+        CSRGraph.from_edge_arrays([0.0, 1.0], [1.0, 0.0])
+
+
+def test_from_csr_arrays():
+    rng = np.random.default_rng(1234)
+    dense = rng.random((20, 20)) < 0.2
+    # Make sure that the last vertex is incident on an edge.
+    dense[0, -1] = True
+    matrix = scipy.sparse.csr_array(dense)
+
+    graph, edge_ids = CSRGraph.from_csr_arrays(matrix.indptr, matrix.indices)
+    assert graph.num_vertices == 20
+    assert graph.num_edges == matrix.nnz
+
+    indptr, indices, _ = graph.csr_arrays()
+    np.testing.assert_array_equal(indptr, matrix.indptr)
+    np.testing.assert_array_equal(indices, matrix.indices)
+
+    tails = np.repeat(np.arange(20), np.diff(matrix.indptr))
+    edges = graph.edge_array()
+    np.testing.assert_array_equal(edges[edge_ids, 0], tails)
+    np.testing.assert_array_equal(edges[edge_ids, 1], matrix.indices)
+
+
+@pytest.mark.parametrize(
+    ("indptr", "indices", "match"),
+    [
+        ([], [], "must not be empty"),
+        ([1, 2, 2], [1, 0], "start at zero"),
+        ([0, 1, 3], [1, 0], "end at the total"),
+        ([0, 2, 1, 2], [1, 2], "non-decreasing"),
+        ([0, 1, 2], [1, 2], "less than the number of vertices"),
+        ([0, 1, 2, 2], [1, 0], "trailing isolated vertices"),
+        ([0, 1, 2], [1, -1], "negative"),
+    ],
+)
+def test_from_csr_arrays_invalid(indptr, indices, match):
+    with pytest.raises(ValueError, match=match):
+        CSRGraph.from_csr_arrays(indptr, indices)
+
+
+def test_edge_list_from_arrays():
+    edge_list = EdgeList.from_arrays(
+        np.array([0, 1, 2], dtype=np.int32), np.array([1, 2, 0], dtype=np.int32)
+    )
+    assert len(edge_list) == 3
+
+    with pytest.raises(ValueError, match="negative"):
+        EdgeList.from_arrays([0, -1], [1, 0])
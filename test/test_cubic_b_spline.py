@@ -0,0 +1,328 @@
+import numpy as np
+import pytest
+
+from whirlwind.spline import BiCubicBSpline, CubicBSpline, TriCubicBSpline
+
+
+def make_splines():
+    x = np.linspace(0.0, 1.0, 9)
+    rng = np.random.default_rng(0)
+    return [
+        CubicBSpline.interpolate(x, rng.random(9)),
+        BiCubicBSpline.interpolate((x, x), rng.random((9, 9))),
+        TriCubicBSpline.interpolate((x, x, x), rng.random((9, 9, 9))),
+    ]
+
+
+def spline_coords(spline, shape):
+    num_coords = 1 if isinstance(spline, CubicBSpline) else len(spline.knots)
+    rng = np.random.default_rng(1)
+    return [rng.random(shape) for _ in range(num_coords)]
+
+
+@pytest.mark.parametrize("spline", make_splines())
+def test_evaluate_into_float32_out(spline):
+    coords = spline_coords(spline, (4, 5))
+
+    expected = spline(*coords)
+    out = np.full((4, 5), np.nan, dtype=np.float32)
+    result = spline(*coords, out=out)
+    assert result is out
+    np.testing.assert_allclose(out, expected, rtol=1e-6)
+
+    expected = spline.evaluate(*coords)
+    out = np.full(expected.shape, np.nan, dtype=np.float32)
+    result = spline.evaluate(*coords, out=out)
+    assert result is out
+    np.testing.assert_allclose(out, expected, rtol=1e-5, atol=1e-5)
+
+
+@pytest.mark.parametrize("spline", make_splines())
+@pytest.mark.parametrize("dtype", [np.float16, np.int32, np.complex128])
+def test_evaluate_into_wrong_dtype_out(spline, dtype):
+    coords = spline_coords(spline, (4, 5))
+    with pytest.raises(ValueError, match="data type"):
+        spline(*coords, out=np.empty((4, 5), dtype=dtype))
+    with pytest.raises(ValueError, match="data type"):
+        spline.evaluate(*coords, out=np.empty((3, 4, 5), dtype=dtype))
+
+
+@pytest.mark.parametrize("spline", make_splines())
+def test_evaluate_into_strided_out(spline):
+    coords = spline_coords(spline, (4, 5))
+    with pytest.raises(ValueError, match="C-contiguous"):
+        spline(*coords, out=np.empty((5, 4)).T)
+    with pytest.raises(ValueError, match="C-contiguous"):
+        spline(*coords, out=np.empty((4, 10))[:, ::2])
+    num_derivatives = len(spline.evaluate(*coords))
+    out = np.empty((2 * num_derivatives, 4, 5))[::2]
+    with pytest.raises(ValueError, match="C-contiguous"):
+        spline.evaluate(*coords, out=out)
+
+
+@pytest.mark.parametrize("spline", make_splines())
+def test_evaluate_into_wrong_shape_out(spline):
+    coords = spline_coords(spline, (4, 5))
+    with pytest.raises(ValueError, match="shape"):
+        spline(*coords, out=np.empty(20))
+    with pytest.raises(ValueError, match="shape"):
+        spline.evaluate(*coords, out=np.empty((4, 5)))
+
+
+@pytest.mark.parametrize("num_knots", [4, 9, 33])
+def test_interpolate_round_trip(num_knots):
+    rng = np.random.default_rng(2)
+    # Non-uniform knots exercise the general interval search.
+    x0 = np.sort(rng.random(num_knots))
+    x1 = np.linspace(-1.0, 1.0, num_knots + 1)
+    x2 = np.linspace(0.0, 2.0, 5)
+
+    values = rng.random(num_knots)
+    spline = CubicBSpline.interpolate(x0, values)
+    np.testing.assert_allclose(spline(x0), values, atol=1e-10)
+
+    values = rng.random((num_knots, num_knots + 1))
+    spline = BiCubicBSpline.interpolate((x0, x1), values)
+    grid = np.meshgrid(x0, x1, indexing="ij")
+    np.testing.assert_allclose(spline(*grid), values, atol=1e-10)
+
+    values = rng.random((num_knots, num_knots + 1, 5))
+    spline = TriCubicBSpline.interpolate((x0, x1, x2), values)
+    grid = np.meshgrid(x0, x1, x2, indexing="ij")
+    np.testing.assert_allclose(spline(*grid), values, atol=1e-10)
+
+
+@pytest.mark.parametrize("spline", make_splines())
+@pytest.mark.parametrize("num_threads", [0, 1, 3])
+def test_batch_evaluate_matches_scalar(spline, num_threads):
+    # Enough points to span several blocks of the batch kernels, plus a remainder.
+    coords = spline_coords(spline, (1037,))
+    batch = spline(*coords, num_threads=num_threads)
+    scalar = [spline(*(float(x[i]) for x in coords)) for i in range(1037)]
+    np.testing.assert_allclose(batch, scalar, rtol=1e-12, atol=1e-12)
+
+    values = spline.evaluate(*coords, num_threads=num_threads)
+    np.testing.assert_allclose(values[0], batch, rtol=1e-12, atol=1e-12)
+
+
+def test_batch_evaluate_derivatives():
+    x = np.linspace(0.0, 1.0, 17)
+    spline = CubicBSpline.interpolate(x, np.sin(3.0 * x))
+
+    t = np.linspace(0.1, 0.9, 101)
+    h = 1e-5
+    values = spline.evaluate(t, derivatives=(0, 1, 2))
+    lower = spline.evaluate(t - h, derivatives=(0, 1))
+    upper = spline.evaluate(t + h, derivatives=(0, 1))
+    np.testing.assert_allclose(values[1], (upper[0] - lower[0]) / (2.0 * h), atol=1e-6)
+    np.testing.assert_allclose(values[2], (upper[1] - lower[1]) / (2.0 * h), atol=1e-4)
+
+
+@pytest.mark.parametrize("spline", make_splines()[1:])
+def test_broadcast_scalar_coords(spline):
+    rng = np.random.default_rng(3)
+    x = rng.random((4, 5))
+    scalars = [0.3, 0.7][: len(spline.knots) - 1]
+    expected = spline(x, *(np.full_like(x, s) for s in scalars))
+    np.testing.assert_array_equal(spline(x, *scalars), expected)
+    np.testing.assert_array_equal(spline.evaluate(x, *scalars)[0], expected)
+
+
+@pytest.mark.parametrize("spline", make_splines()[1:])
+def test_broadcast_coords(spline):
+    rng = np.random.default_rng(4)
+    ndim = len(spline.knots)
+    # Each coordinate varies along a different axis of the output.
+    coords = [
+        rng.random(n).reshape([-1 if d == i else 1 for d in range(ndim)])
+        for i, n in enumerate((4, 5, 6)[:ndim])
+    ]
+    shape = np.broadcast_shapes(*(x.shape for x in coords))
+    expanded = [np.ascontiguousarray(np.broadcast_to(x, shape)) for x in coords]
+
+    expected = spline(*expanded)
+    np.testing.assert_array_equal(spline(*coords), expected)
+    # Stride-0 views, as returned by `numpy.broadcast_to`.
+    stride0 = [np.broadcast_to(x, shape) for x in coords]
+    np.testing.assert_array_equal(spline(*stride0), expected)
+    np.testing.assert_array_equal(
+        spline.evaluate(*stride0), spline.evaluate(*expanded)
+    )
+
+
+@pytest.mark.parametrize("spline", make_splines())
+def test_strided_coords(spline):
+    rng = np.random.default_rng(5)
+    base = [rng.random((10, 12)) for _ in spline_coords(spline, ())]
+    for view in (lambda x: x[::2, 1::3], lambda x: x.T, lambda x: x[:, ::-1]):
+        coords = [view(x) for x in base]
+        contiguous = [np.ascontiguousarray(x) for x in coords]
+        np.testing.assert_array_equal(spline(*coords), spline(*contiguous))
+        np.testing.assert_array_equal(
+            spline.evaluate(*coords), spline.evaluate(*contiguous)
+        )
+
+
+@pytest.mark.parametrize("spline", make_splines()[1:])
+def test_broadcast_shape_mismatch(spline):
+    coords = [np.zeros(3)] + [np.zeros(4)] * (len(spline.knots) - 1)
+    with pytest.raises(ValueError, match="shape mismatch"):
+        spline(*coords)
+    with pytest.raises(ValueError, match="shape mismatch"):
+        spline.evaluate(*coords)
+    with pytest.raises(ValueError, match="shape mismatch"):
+        spline(*coords, out=np.empty(4))
+
+
+@pytest.mark.parametrize("axis", [0, 1, 2, -1])
+def test_slice(axis):
+    rng = np.random.default_rng(6)
+    knots = (np.linspace(0.0, 1.0, 7), np.sort(rng.random(8)), np.linspace(-2, 2, 9))
+    spline = TriCubicBSpline.interpolate(knots, rng.random((7, 8, 9)))
+
+    # Points on the endpoints of the remaining axes, and in their interior.
+    points = []
+    for d in range(3):
+        if d != axis % 3:
+            lo, hi = knots[d][[0, -1]]
+            points.append(np.concatenate([[lo, hi], rng.uniform(lo, hi, 5)]))
+    ya, yb = np.meshgrid(*points, indexing="ij")
+
+    lo, hi = knots[axis][[0, -1]]
+    for x in (lo, hi, 0.5 * (lo + hi), lo + 0.3 * (hi - lo)):
+        sliced = spline.slice(axis, x)
+        coords = [ya, yb]
+        coords.insert(axis % 3, np.full_like(ya, x))
+        np.testing.assert_allclose(sliced(ya, yb), spline(*coords), atol=1e-12)
+
+
+def test_slice_out_of_range():
+    x = np.linspace(0.0, 1.0, 5)
+    spline = TriCubicBSpline.interpolate((x, x, x), np.zeros((5, 5, 5)))
+    for value in (-0.1, 1.1, np.nan):
+        with pytest.raises(ValueError, match="knot range"):
+            spline.slice(0, value)
+
+
+def make_non_uniform_splines(knots):
+    rng = np.random.default_rng(7)
+    n = len(knots)
+    return [
+        CubicBSpline.interpolate(knots, rng.random(n)),
+        BiCubicBSpline.interpolate((knots, knots), rng.random((n, n))),
+        TriCubicBSpline.interpolate((knots, knots, knots), rng.random((n, n, n))),
+    ]
+
+
+def assert_batch_matches_scalar(spline, coords):
+    batch = spline(*coords)
+    scalar = [spline(*(float(x[i]) for x in coords)) for i in range(len(coords[0]))]
+    np.testing.assert_allclose(batch, scalar, rtol=1e-12, atol=1e-12)
+    values = spline.evaluate(*coords)[0]
+    np.testing.assert_allclose(values, batch, rtol=1e-12, atol=1e-12)
+
+
+NON_UNIFORM_KNOTS = {
+    # One knot of an otherwise uniform grid is displaced by much more than rounding
+    # error, so the knots must not be detected as uniform.
+    "perturbed": np.linspace(0.0, 1.0, 11) + np.eye(11)[5] * 1e-3,
+    "geometric": np.geomspace(1.0, 100.0, 12),
+    "clustered": np.sort(np.random.default_rng(8).random(15)),
+}
+
+
+@pytest.mark.parametrize("name", NON_UNIFORM_KNOTS)
+def test_non_uniform_knots(name):
+    knots = NON_UNIFORM_KNOTS[name]
+    for spline in make_non_uniform_splines(knots):
+        rng = np.random.default_rng(9)
+        num_coords = len(spline_coords(spline, ()))
+        coords = [rng.uniform(knots[0], knots[-1], 300) for _ in range(num_coords)]
+        assert_batch_matches_scalar(spline, coords)
+
+
+def gallop_coords(knots, order):
+    lo, hi = knots[0], knots[-1]
+    x = np.sort(np.random.default_rng(10).uniform(lo, hi, 257))
+    if order == "descending":
+        return x[::-1]
+    if order == "shuffled":
+        return np.random.default_rng(11).permutation(x)
+    if order == "alternating":
+        # Jump between the two ends of the knot vector on every point.
+        return np.stack([x[:128], x[::-1][:128]], axis=1).ravel()
+    if order == "out-of-range":
+        span = hi - lo
+        return np.concatenate([x[::-1], [lo - span, hi + span, lo, hi], x])
+    raise ValueError(order)
+
+
+@pytest.mark.parametrize(
+    "order", ["descending", "shuffled", "alternating", "out-of-range"]
+)
+def test_non_uniform_knot_search_order(order):
+    knots = NON_UNIFORM_KNOTS["clustered"]
+    x = gallop_coords(knots, order)
+    for spline in make_non_uniform_splines(knots):
+        num_coords = len(spline_coords(spline, ()))
+        # Vary the order of each coordinate differently.
+        coords = [np.roll(x, 37 * i) for i in range(num_coords)]
+
+        # Points outside the knots are extrapolated from the nearest interval by the
+        # batch kernels, so compare with batches of a single point, whose interval
+        # search starts afresh.
+        batch = spline(*coords)
+        single = [spline(*(c[i : i + 1] for c in coords))[0] for i in range(len(x))]
+        np.testing.assert_allclose(batch, single, rtol=1e-12, atol=1e-12)
+
+        inside = np.all([(c >= knots[0]) & (c <= knots[-1]) for c in coords], axis=0)
+        assert_batch_matches_scalar(spline, [c[inside] for c in coords])
+
+
+def central_difference(func, coords, axis, h):
+    lower = list(coords)
+    upper = list(coords)
+    lower[axis] = coords[axis] - h
+    upper[axis] = coords[axis] + h
+    return (func(*upper) - func(*lower)) / (2.0 * h)
+
+
+@pytest.mark.parametrize("ndim", [2, 3])
+def test_batch_evaluate_partial_derivatives(ndim):
+    # Non-uniform knots along the last axis exercise the generic basis weights too.
+    knots = [
+        np.linspace(0.0, 1.0, 13),
+        np.linspace(-1.0, 2.0, 11),
+        np.geomspace(1.0, 3.0, 9),
+    ][:ndim]
+    grid = np.meshgrid(*knots, indexing="ij")
+    values = np.sin(2.0 * grid[0]) * np.cos(grid[1]) * (grid[-1] if ndim == 3 else 1.0)
+    cls = BiCubicBSpline if ndim == 2 else TriCubicBSpline
+    spline = cls.interpolate(tuple(knots), values)
+
+    rng = np.random.default_rng(12)
+    coords = [rng.uniform(k[1], k[-2], 200) for k in knots]
+    h = 1e-5
+
+    first = [tuple(int(d == axis) for d in range(ndim)) for axis in range(ndim)]
+    second = [tuple(2 * int(d == axis) for d in range(ndim)) for axis in range(ndim)]
+    mixed = [tuple(int(d in (0, 1)) for d in range(ndim))]
+    zero = tuple([0] * ndim)
+    results = spline.evaluate(*coords, derivatives=[zero, *first, *second, *mixed])
+    np.testing.assert_allclose(results[0], spline(*coords), rtol=1e-12, atol=1e-12)
+
+    for axis in range(ndim):
+        expected = central_difference(spline, coords, axis, h)
+        np.testing.assert_allclose(results[1 + axis], expected, atol=1e-5)
+
+        def partial(*x, orders=first[axis]):
+            return spline.evaluate(*x, derivatives=[orders])[0]
+
+        expected = central_difference(partial, coords, axis, h)
+        np.testing.assert_allclose(results[1 + ndim + axis], expected, atol=1e-3)
+
+    def partial0(*x):
+        return spline.evaluate(*x, derivatives=[first[0]])[0]
+
+    expected = central_difference(partial0, coords, 1, h)
+    np.testing.assert_allclose(results[-1], expected, atol=1e-4)
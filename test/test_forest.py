@@ -0,0 +1,106 @@
+import numpy as np
+import pytest
+
+from whirlwind.graph import CSRGraph, Forest
+
+
+def make_forest(parents):
+    """Make a forest whose i-th vertex has parent `parents[i]` (or -1 for a root)."""
+    parents = np.asarray(parents)
+    children = np.flatnonzero(parents >= 0)
+    graph, edge_ids = CSRGraph.from_edge_arrays(
+        parents[children], children, num_vertices=len(parents)
+    )
+    forest = Forest(graph)
+    for child, edge_id in zip(children, edge_ids):
+        forest.set_predecessor(int(child), int(parents[child]), int(edge_id))
+    return forest
+
+
+def random_parents(num_vertices, seed):
+    rng = np.random.default_rng(seed)
+    parents = np.array([-1] + [rng.integers(0, i) for i in range(1, num_vertices)])
+    parents[rng.random(num_vertices) < 0.05] = -1
+    # The last vertex must be incident on an edge.
+    parents[-1] = 0
+    return parents
+
+
+def test_roots_and_depths():
+    forest = make_forest([-1, 0, 1, 2, -1, 4])
+    np.testing.assert_array_equal(forest.root_vertex_array(), [0, 0, 0, 0, 4, 4])
+    np.testing.assert_array_equal(forest.depth_array(), [0, 1, 2, 3, 0, 1])
+
+
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_roots_and_depths_match_iteration(num_threads):
+    parents = random_parents(500, seed=0)
+    forest = make_forest(parents)
+
+    roots = np.empty(len(parents), dtype=np.int64)
+    for i in range(len(parents)):
+        path = list(forest.predecessors(i))
+        roots[i] = path[-1][0] if path else i
+
+    np.testing.assert_array_equal(
+        forest.root_vertex_array(num_threads=num_threads), roots
+    )
+    np.testing.assert_array_equal(
+        forest.depth_array(num_threads=num_threads),
+        [forest.depth(i) for i in range(len(parents))],
+    )
+
+
+def test_paths_to_root():
+    forest = make_forest([-1, 0, 1, 2, -1, 4])
+    offsets, pred_vertex_ids, pred_edge_ids = forest.paths_to_root([3, 0, 5])
+
+    np.testing.assert_array_equal(offsets, [0, 3, 3, 4])
+    np.testing.assert_array_equal(pred_vertex_ids, [2, 1, 0, 4])
+    expected_edges = [forest.predecessor_edge(v) for v in (3, 2, 1, 5)]
+    np.testing.assert_array_equal(pred_edge_ids, expected_edges)
+
+
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_paths_to_root_match_iteration(num_threads):
+    parents = random_parents(500, seed=1)
+    forest = make_forest(parents)
+    vertex_ids = np.random.default_rng(2).integers(0, len(parents), size=100)
+
+    offsets, pred_vertex_ids, pred_edge_ids = forest.paths_to_root(
+        vertex_ids, num_threads=num_threads
+    )
+    assert len(offsets) == len(vertex_ids) + 1
+    for i, vertex in enumerate(vertex_ids):
+        path = list(forest.predecessors(int(vertex)))
+        start, stop = offsets[i], offsets[i + 1]
+        np.testing.assert_array_equal(pred_vertex_ids[start:stop], [v for v, _ in path])
+        np.testing.assert_array_equal(pred_edge_ids[start:stop], [e for _, e in path])
+
+
+def test_paths_to_root_invalid_vertex_ids():
+    forest = make_forest([-1, 0, 1])
+    with pytest.raises(ValueError, match="negative"):
+        forest.paths_to_root([0, -1])
+    with pytest.raises(ValueError, match="less than the number of vertices"):
+        forest.paths_to_root([0, 3])
+    with pytest.raises(TypeError, match="integers"):
+        forest.paths_to_root([0.0, 1.0])
+
+    offsets, pred_vertex_ids, _ = forest.paths_to_root([])
+    np.testing.assert_array_equal(offsets, [0])
+    assert len(pred_vertex_ids) == 0
+
+
+def test_cycle():
+    graph, edge_ids = CSRGraph.from_edge_arrays([0, 1, 1], [1, 0, 2])
+    forest = Forest(graph)
+    forest.set_predecessor(1, 0, int(edge_ids[0]))
+    forest.set_predecessor(0, 1, int(edge_ids[1]))
+
+    with pytest.raises(ValueError, match="cycle"):
+        forest.root_vertex_array()
+    with pytest.raises(ValueError, match="cycle"):
+        forest.depth_array()
+    with pytest.raises(ValueError, match="cycle"):
+        forest.paths_to_root([1])
@@ -0,0 +1,68 @@
+import numpy as np
+import pytest
+
+from whirlwind.graph import CSRGraph, RectangularGridGraph
+
+
+def make_csr_graph():
+    rng = np.random.default_rng(0)
+    tails = rng.integers(0, 30, size=100)
+    heads = rng.integers(0, 30, size=100)
+    tails[0] = 29
+    graph, _ = CSRGraph.from_edge_arrays(tails, heads)
+    return graph
+
+
+GRAPHS = {
+    "grid": lambda: RectangularGridGraph(5, 7),
+    "grid-parallel": lambda: RectangularGridGraph(5, 7, num_parallel_edges=2),
+    "grid-uint32": lambda: RectangularGridGraph(5, 7, index_dtype=np.uint32),
+    "csr": make_csr_graph,
+}
+
+
+def iterate_graph(graph):
+    """Get the outdegrees, edges and CSR arrays of a graph by per-vertex iteration."""
+    outdegrees = np.zeros(graph.num_vertices, dtype=np.int64)
+    edges = np.zeros((graph.num_edges, 2), dtype=np.int64)
+    indptr = [0]
+    indices = []
+    edge_ids = []
+    for vertex in graph.vertices():
+        tail = graph.get_vertex_id(vertex)
+        for edge, head in graph.outgoing_edges(vertex):
+            edge_id = graph.get_edge_id(edge)
+            edges[edge_id] = tail, graph.get_vertex_id(head)
+            indices.append(graph.get_vertex_id(head))
+            edge_ids.append(edge_id)
+        outdegrees[tail] = graph.outdegree(vertex)
+        indptr.append(len(indices))
+    return outdegrees, edges, (np.array(indptr), np.array(indices), np.array(edge_ids))
+
+
+@pytest.mark.parametrize("name", GRAPHS)
+def test_topology_arrays_match_iteration(name):
+    graph = GRAPHS[name]()
+    outdegrees, edges, (indptr, indices, edge_ids) = iterate_graph(graph)
+
+    np.testing.assert_array_equal(graph.outdegree_array(), outdegrees)
+    np.testing.assert_array_equal(graph.edge_array(), edges)
+
+    actual_indptr, actual_indices, actual_edge_ids = graph.csr_arrays()
+    np.testing.assert_array_equal(actual_indptr, indptr)
+    np.testing.assert_array_equal(actual_indices, indices)
+    np.testing.assert_array_equal(actual_edge_ids, edge_ids)
+
+
+def test_parallel_grid_edges():
+    graph = RectangularGridGraph(5, 7)
+    parallel = RectangularGridGraph(5, 7, num_parallel_edges=2)
+    assert parallel.num_edges == 2 * graph.num_edges
+    np.testing.assert_array_equal(
+        parallel.outdegree_array(), 2 * graph.outdegree_array()
+    )
+
+    # Each edge of the simple grid appears twice in the parallel grid.
+    edges = graph.edge_array().tolist()
+    parallel_edges = parallel.edge_array().tolist()
+    assert sorted(map(tuple, parallel_edges)) == sorted(map(tuple, 2 * edges))
@@ -0,0 +1,36 @@
+import numpy as np
+import pytest
+
+from whirlwind._lib import integrate_unwrapped_gradients
+from whirlwind._lib import residue as get_residues
+from whirlwind.graph import RectangularGridGraph
+from whirlwind.network import Network, primal_dual
+
+
+def solve(phase, cost, index_dtype):
+    residue = get_residues(phase)
+    graph = RectangularGridGraph(*residue.shape, index_dtype=index_dtype)
+    network = Network(graph, residue.ravel(), cost, capacity=1)
+    primal_dual(network, maxiter=8)
+    assert network.is_balanced()
+    unwrapped = integrate_unwrapped_gradients(phase, network._impl)
+    return network.edge_flow_array(), unwrapped
+
+
+@pytest.mark.parametrize("index_dtype", [np.uint32, np.uint64, "auto"])
+def test_index_types_give_same_solution(index_dtype):
+    rng = np.random.default_rng(0)
+    phase = np.angle(np.exp(1j * rng.normal(scale=2.0, size=(12, 15))))
+    num_edges = RectangularGridGraph(13, 16).num_edges
+    cost = rng.integers(1, 100, size=num_edges).astype(np.int32)
+
+    expected_flow, expected_unwrapped = solve(phase, cost, None)
+    flow, unwrapped = solve(phase, cost, index_dtype)
+    np.testing.assert_array_equal(flow, expected_flow)
+    np.testing.assert_allclose(unwrapped, expected_unwrapped)
+
+
+def test_auto_index_type_is_narrow():
+    graph = RectangularGridGraph(13, 16, index_dtype="auto")
+    narrow = RectangularGridGraph(13, 16, index_dtype=np.uint32)
+    assert type(graph._impl) is type(narrow._impl)
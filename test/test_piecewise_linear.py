@@ -0,0 +1,82 @@
+import numpy as np
+import pytest
+import scipy.optimize
+
+from whirlwind.graph import RectangularGridGraph
+from whirlwind.network import (
+    piecewise_linear_edge_flows,
+    piecewise_linear_network,
+    primal_dual,
+)
+
+
+def min_convex_cost(edges, surplus, segment_costs):
+    """Solve the expanded problem, with one unit-capacity edge per segment, by LP."""
+    num_segments, num_edges = segment_costs.shape
+    tails = np.tile(edges[:, 0], num_segments)
+    heads = np.tile(edges[:, 1], num_segments)
+    incidence = np.zeros((len(surplus), len(tails)))
+    incidence[tails, np.arange(len(tails))] += 1
+    incidence[heads, np.arange(len(tails))] -= 1
+    result = scipy.optimize.linprog(
+        segment_costs.ravel(), A_eq=incidence, b_eq=surplus, bounds=(0, 1)
+    )
+    assert result.success
+    return result.fun
+
+
+def convex_cost(flow, segment_costs):
+    # The k-th unit of flow along an edge costs `segment_costs[k-1]`.
+    used = np.arange(len(segment_costs))[:, None] < flow
+    return np.sum(segment_costs * used)
+
+
+@pytest.mark.parametrize("num_segments", [1, 2, 3, 5])
+def test_piecewise_linear_network(num_segments):
+    rng = np.random.default_rng(num_segments)
+    graph = RectangularGridGraph(5, 6)
+    edges = graph.edge_array().astype(np.int64)
+
+    increments = rng.integers(0, 20, size=(num_segments, graph.num_edges))
+    segment_costs = np.cumsum(increments, axis=0)
+
+    # Several units of flow from a few sources to a few sinks, so that some edges carry
+    # more than one unit.
+    surplus = np.zeros(graph.num_vertices, dtype=np.int32)
+    surplus[[0, 1, 6]] = num_segments
+    surplus[[-1, -2, -7]] = -num_segments
+
+    if num_segments <= 2:
+        network = piecewise_linear_network(graph, surplus, segment_costs)
+    else:
+        with pytest.warns(UserWarning, match="falls back to a CSRGraph"):
+            network = piecewise_linear_network(graph, surplus, segment_costs)
+    primal_dual(network)
+    assert network.is_balanced()
+
+    flow = piecewise_linear_edge_flows(network).astype(np.int64)
+    assert flow.shape == (graph.num_edges,)
+    assert np.all((flow >= 0) & (flow <= num_segments))
+
+    outflow = np.bincount(edges[:, 0], weights=flow, minlength=graph.num_vertices)
+    inflow = np.bincount(edges[:, 1], weights=flow, minlength=graph.num_vertices)
+    np.testing.assert_array_equal(outflow - inflow, surplus)
+
+    expected = min_convex_cost(edges, surplus, segment_costs)
+    assert convex_cost(flow, segment_costs) == pytest.approx(expected)
+
+
+def test_piecewise_linear_network_invalid_costs():
+    graph = RectangularGridGraph(3, 3)
+    surplus = np.zeros(graph.num_vertices, dtype=np.int32)
+
+    decreasing = np.zeros((2, graph.num_edges), dtype=np.int32)
+    decreasing[0] = 1
+    with pytest.raises(ValueError, match="non-decreasing"):
+        piecewise_linear_network(graph, surplus, decreasing)
+    with pytest.raises(ValueError, match="32-bit"):
+        piecewise_linear_network(
+            graph, surplus, np.full((1, graph.num_edges), 2**40, dtype=np.int64)
+        )
+    with pytest.raises(TypeError, match="integers"):
+        piecewise_linear_network(graph, surplus, np.zeros((1, graph.num_edges)))
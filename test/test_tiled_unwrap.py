@@ -0,0 +1,140 @@
+import numpy as np
+import pytest
+
+import whirlwind as ww
+from whirlwind._unwrap import (
+    _estimate_tile_offset,
+    _get_core_bounds,
+    _get_tile_bounds,
+    _reconcile_tile_offsets,
+)
+
+
+def test_tile_bounds():
+    bounds = _get_tile_bounds(100, 40, 10)
+    assert bounds[0][0] == 0
+    assert bounds[-1][1] == 100
+    assert all(b - a == 40 for a, b in bounds)
+    assert all(b[0] <= a[1] - 10 for a, b in zip(bounds, bounds[1:]))
+
+    cores = _get_core_bounds(bounds)
+    assert cores[0][0] == 0
+    assert cores[-1][1] == 100
+    assert all(a[1] == b[0] for a, b in zip(cores, cores[1:]))
+    assert all(t0 <= c0 < c1 <= t1 for (c0, c1), (t0, t1) in zip(cores, bounds))
+
+
+def test_estimate_tile_offset():
+    rng = np.random.default_rng(0)
+    a = rng.normal(scale=10.0, size=(8, 20))
+    b = a - 2.0 * np.pi * 3 + rng.normal(scale=0.1, size=a.shape)
+    assert _estimate_tile_offset(a, b) == (3, 1001)
+
+    # Disagreeing samples lower the weight without changing the offset.
+    b[:2] -= 2.0 * np.pi
+    offset, weight = _estimate_tile_offset(a, b)
+    assert offset == 3
+    assert weight == 1 + int(1000.0 * 0.75)
+
+
+def make_pairwise_offsets(offsets):
+    dh = offsets[:, 1:] - offsets[:, :-1]
+    dv = offsets[1:, :] - offsets[:-1, :]
+    return dh, dv, np.full(dh.shape, 1000), np.full(dv.shape, 1000)
+
+
+def test_reconcile_consistent_offsets():
+    rng = np.random.default_rng(1)
+    offsets = rng.integers(-5, 6, size=(4, 5))
+    offsets -= offsets[0, 0]
+    reconciled = _reconcile_tile_offsets(*make_pairwise_offsets(offsets))
+    np.testing.assert_array_equal(reconciled, offsets)
+
+
+@pytest.mark.parametrize(("axis", "pair"), [(0, (1, 2)), (0, (0, 0)), (1, (1, 3))])
+def test_reconcile_inconsistent_offsets(axis, pair):
+    rng = np.random.default_rng(2)
+    offsets = rng.integers(-5, 6, size=(4, 5))
+    offsets -= offsets[0, 0]
+    dh, dv, wh, wv = make_pairwise_offsets(offsets)
+
+    # Corrupt a single pairwise offset with a low weight. This creates residues in the
+    # loops on either side of the pair, which must be resolved by correcting only the
+    # corrupted pair.
+    d, w = (dh, wh) if axis == 0 else (dv, wv)
+    d[pair] += 2
+    w[pair] = 10
+
+    reconciled = _reconcile_tile_offsets(dh, dv, wh, wv)
+    np.testing.assert_array_equal(reconciled, offsets)
+
+
+def test_tiled_unwrap_matches_untiled():
+    y, x = np.mgrid[:96, :96]
+    phase = 0.02 * (x - 40.0) ** 2 / 4.0 + 0.3 * y
+    igram = np.exp(1j * phase).astype(np.complex64)
+    corr = np.full(igram.shape, 0.9, dtype=np.float32)
+
+    untiled = ww.unwrap(igram, corr, nlooks=10.0)
+    tiled = ww.unwrap(igram, corr, nlooks=10.0, tile_shape=(40, 40), tile_overlap=16)
+
+    cycles = np.rint((tiled - untiled) / (2.0 * np.pi))
+    assert np.all(cycles == cycles[0, 0])
+    np.testing.assert_allclose(tiled - 2.0 * np.pi * cycles, untiled, atol=1e-4)
+
+
+@pytest.mark.parametrize("tile_shape", [None, (40, 40)])
+def test_unwrap_into_memmap(tmp_path, tile_shape):
+    y, x = np.mgrid[:96, :96]
+    phase = 0.02 * (x - 40.0) ** 2 / 4.0 + 0.3 * y
+    igram = np.exp(1j * phase).astype(np.complex64)
+    corr = np.full(igram.shape, 0.9, dtype=np.float32)
+    kwargs = {"tile_shape": tile_shape, "tile_overlap": 16}
+
+    expected = ww.unwrap(igram, corr, nlooks=10.0, **kwargs)
+
+    path = tmp_path / "unwrapped.npy"
+    out = np.lib.format.open_memmap(path, mode="w+", dtype=np.float32, shape=(96, 96))
+    unwrapped = ww.unwrap(igram, corr, nlooks=10.0, out=out, **kwargs)
+    assert unwrapped is out
+    out.flush()
+    del out, unwrapped
+
+    np.testing.assert_array_equal(np.load(path), expected)
+
+
+def test_unwrap_out_mismatch():
+    igram = np.ones((16, 16), dtype=np.complex64)
+    corr = np.ones(igram.shape, dtype=np.float32)
+    with pytest.raises(ValueError, match="same shape"):
+        ww.unwrap(igram, corr, nlooks=1.0, out=np.empty((16, 15), dtype=np.float32))
+    with pytest.raises(TypeError, match="float32 or float64"):
+        ww.unwrap(igram, corr, nlooks=1.0, out=np.empty((16, 16), dtype=np.int32))
+
+
+def test_coarse_reference_unwrap():
+    # A ramp with a bump that spans several tiles, whose phase gradient is still small
+    # enough to be unwrapped after multilooking.
+    y, x = np.mgrid[:128, :128]
+    bump = np.exp(-((x - 64.0) ** 2 + (y - 64.0) ** 2) / 800.0)
+    phase = 0.15 * x + 0.1 * y + 6.0 * bump
+    igram = np.exp(1j * phase).astype(np.complex64)
+    corr = np.full(igram.shape, 0.9, dtype=np.float32)
+
+    untiled = ww.unwrap(igram, corr, nlooks=10.0)
+    aligned = ww.unwrap(
+        igram, corr, nlooks=10.0, coarse_looks=2, tile_shape=(48, 48), tile_overlap=16
+    )
+
+    # Each tile is solved as in plain tiled mode and shifted by a whole number of
+    # cycles, so the result differs from the single-network solution by a constant.
+    cycles = np.rint((aligned - untiled) / (2.0 * np.pi))
+    assert np.all(cycles == cycles[0, 0])
+    np.testing.assert_allclose(aligned - 2.0 * np.pi * cycles, untiled, atol=1e-4)
+
+
+def test_coarse_looks_too_large():
+    igram = np.ones((16, 16), dtype=np.complex64)
+    corr = np.ones(igram.shape, dtype=np.float32)
+    with pytest.raises(ValueError, match="coarse_looks is too large"):
+        ww.unwrap(igram, corr, nlooks=1.0, coarse_looks=16)
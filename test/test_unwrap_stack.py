@@ -0,0 +1,63 @@
+import numpy as np
+import pytest
+
+import whirlwind as ww
+
+
+def make_stack(count, shape, seed):
+    rng = np.random.default_rng(seed)
+    y, x = np.indices(shape)
+    slopes = rng.uniform(-0.5, 0.5, size=(count, 2))
+    phase = slopes[:, :1, None] * x + slopes[:, 1:, None] * y
+    # Noise creates residues, so that each network has something to solve.
+    phase = phase + rng.normal(scale=0.8, size=(count, *shape))
+    igrams = np.exp(1j * phase).astype(np.complex64)
+    corrs = rng.uniform(0.3, 0.95, size=(count, *shape)).astype(np.float32)
+    return igrams, corrs
+
+
+@pytest.mark.parametrize("shared_mask", [False, True])
+def test_unwrap_stack_matches_unwrap(shared_mask):
+    # Five interferograms with two worker threads span more than one batch of four.
+    igrams, corrs = make_stack(5, (24, 32), seed=0)
+    nlooks = np.array([1.0, 4.0, 10.0, 20.0, 40.0])
+    masks = np.zeros(igrams.shape, dtype=bool)
+    masks[:, :6, :5] = True
+    masks[2, 10:14, 20:] = True
+    if shared_mask:
+        masks = masks[0]
+
+    unwrapped = ww.unwrap_stack(igrams, corrs, nlooks, masks=masks, num_threads=2)
+    assert unwrapped.shape == igrams.shape
+    assert unwrapped.dtype == np.float32
+
+    for i in range(len(igrams)):
+        mask = masks if shared_mask else masks[i]
+        expected = ww.unwrap(igrams[i], corrs[i], nlooks[i], mask=mask)
+        np.testing.assert_array_equal(unwrapped[i], expected)
+
+
+def test_unwrap_stack_scalar_nlooks():
+    igrams, corrs = make_stack(3, (16, 16), seed=1)
+    unwrapped = ww.unwrap_stack(igrams, corrs, 10.0)
+    for i in range(len(igrams)):
+        expected = ww.unwrap(igrams[i], corrs[i], 10.0)
+        np.testing.assert_array_equal(unwrapped[i], expected)
+
+
+def test_unwrap_stack_empty():
+    igrams = np.empty((0, 16, 16), dtype=np.complex64)
+    corrs = np.empty(igrams.shape, dtype=np.float32)
+    assert ww.unwrap_stack(igrams, corrs, 10.0).shape == igrams.shape
+
+
+def test_unwrap_stack_invalid_args():
+    igrams, corrs = make_stack(3, (16, 16), seed=2)
+    with pytest.raises(ValueError, match="3-D"):
+        ww.unwrap_stack(igrams[0], corrs[0], 10.0)
+    with pytest.raises(ValueError, match="same shape"):
+        ww.unwrap_stack(igrams, corrs[:2], 10.0)
+    with pytest.raises(ValueError, match="one entry per interferogram"):
+        ww.unwrap_stack(igrams, corrs, [1.0, 2.0])
+    with pytest.raises(ValueError, match="masks"):
+        ww.unwrap_stack(igrams, corrs, 10.0, masks=np.zeros((16, 15), dtype=bool))